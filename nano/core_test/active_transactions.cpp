@@ -1314,7 +1314,17 @@ TEST (active_transactions, list_active)
 	ASSERT_EQ (3, node.active.list_active (99999).size ());
 	ASSERT_EQ (3, node.active.list_active ().size ());
 
+	// Elections are listed oldest first regardless of the shard they are stored in
 	auto active = node.active.list_active ();
+	ASSERT_EQ (send->qualified_root (), active[0]->qualified_root);
+	ASSERT_EQ (send2->qualified_root (), active[1]->qualified_root);
+	ASSERT_EQ (open->qualified_root (), active[2]->qualified_root);
+
+	node.active.erase_oldest ();
+	ASSERT_EQ (2, node.active.size ());
+	ASSERT_FALSE (node.active.active (*send));
+	ASSERT_TRUE (node.active.active (*send2));
+	ASSERT_TRUE (node.active.active (*open));
 }
 
 TEST (active_transactions, vacancy)
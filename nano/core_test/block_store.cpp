@@ -10,6 +10,7 @@
 #include <nano/secure/utility.hpp>
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
+#include <nano/store/delegator.hpp>
 #include <nano/store/lmdb/lmdb.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 #include <nano/store/versioning.hpp>
@@ -178,6 +179,52 @@ TEST (block_store, clear_successor)
 	}
 }
 
+TEST (block_store, block_cache)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	nano::stats stats;
+	store->block.cache.attach (stats);
+	nano::block_builder builder;
+	auto block1 = builder
+				  .open ()
+				  .source (0)
+				  .representative (1)
+				  .account (0)
+				  .sign (nano::keypair ().prv, 0)
+				  .work (0)
+				  .build ();
+	block1->sideband_set ({});
+	auto transaction (store->tx_begin_write ());
+	store->block.put (transaction, block1->hash (), *block1);
+	auto first (store->block.get (transaction, block1->hash ()));
+	ASSERT_NE (nullptr, first);
+	ASSERT_EQ (1, stats.count (nano::stat::type::block_cache, nano::stat::detail::miss));
+	// Unchanged value is served from the cache
+	auto second (store->block.get (transaction, block1->hash ()));
+	ASSERT_EQ (*first, *second);
+	ASSERT_EQ (1, stats.count (nano::stat::type::block_cache, nano::stat::detail::hit));
+	// The cached block is shared instead of copied
+	ASSERT_EQ (first, second);
+	// Changing the stored value must not return the stale decoded block
+	auto modified_sideband = first->sideband ();
+	modified_sideband.successor = 1;
+	block1->sideband_set (modified_sideband);
+	store->block.put (transaction, block1->hash (), *block1);
+	auto third (store->block.get (transaction, block1->hash ()));
+	ASSERT_NE (nullptr, third);
+	ASSERT_NE (first, third);
+	ASSERT_EQ (1, third->sideband ().successor.number ());
+	ASSERT_EQ (2, stats.count (nano::stat::type::block_cache, nano::stat::detail::miss));
+	// Shrinking the budget evicts entries
+	store->block.cache.set_max_memory (0);
+	ASSERT_EQ (0, store->block.cache.size ());
+	store->block.del (transaction, block1->hash ());
+	ASSERT_EQ (nullptr, store->block.get (transaction, block1->hash ()));
+	ASSERT_EQ (0, store->block.cache.size ());
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	nano::logger logger;
@@ -1400,6 +1447,40 @@ TEST (mdb_block_store, upgrade_v21_v22)
 	// Testing the upgrade code worked
 	check_correct_state ();
 }
+
+TEST (mdb_block_store, upgrade_v22_v23)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+
+	auto path (nano::unique_path () / "data.ldb");
+	nano::logger logger;
+	nano::keypair key1;
+	nano::keypair key2;
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		nano::ledger_cache ledger_cache;
+		store.initialize (transaction, ledger_cache, nano::dev::constants);
+		nano::account_info info1{ 1, key2.pub, 1, 100, 0, 1, nano::epoch::epoch_0 };
+		store.account.put (transaction, key1.pub, info1);
+		// Setting the database to its 22nd version state, before the delegators index existed
+		store.delegator.clear (transaction);
+		store.version.put (transaction, 22);
+	}
+
+	// Testing the upgrade rebuilt the index from the accounts table
+	nano::store::lmdb::component store (logger, path, nano::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_EQ (store.version.get (transaction), store.version_current);
+	ASSERT_EQ (2, store.count (transaction, nano::tables::delegators));
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ nano::dev::genesis_key.pub, nano::dev::genesis_key.pub }));
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ key2.pub, key1.pub }));
+}
 }
 
 namespace nano::store::rocksdb
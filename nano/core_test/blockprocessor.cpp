@@ -39,3 +39,41 @@ TEST (block_processor, broadcast_block_on_arrival)
 	// Checks whether the block was broadcast.
 	ASSERT_TIMELY (5s, node2->ledger.block_or_pruned_exists (send1->hash ()));
 }
+
+/*
+ * Dependent blocks are prevalidated in parallel but must reach the ledger in arrival order, otherwise they would be put into unchecked
+ */
+TEST (block_processor, prevalidation_order)
+{
+	nano::test::system system;
+	nano::node_flags flags;
+	// Single block batches spread the chain across all prevalidation threads
+	flags.block_processor_verification_size = 1;
+	auto & node = *system.add_node (flags);
+	nano::state_block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	auto previous = nano::dev::genesis->hash ();
+	auto const count = 64;
+	for (auto i = 0; i < count; ++i)
+	{
+		auto send = builder.make_block ()
+					.account (nano::dev::genesis_key.pub)
+					.previous (previous)
+					.representative (nano::dev::genesis_key.pub)
+					.balance (nano::dev::constants.genesis_amount - (i + 1))
+					.link (nano::dev::genesis_key.pub)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (*system.work.generate (previous))
+					.build_shared ();
+		previous = send->hash ();
+		blocks.push_back (send);
+	}
+	for (auto const & block : blocks)
+	{
+		node.block_processor.add (block);
+	}
+	ASSERT_TIMELY (5s, node.ledger.block_or_pruned_exists (blocks.back ()->hash ()));
+	ASSERT_EQ (count, node.stats.count (nano::stat::type::blockprocessor, nano::stat::detail::prevalidated));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::ledger, nano::stat::detail::gap_previous));
+	ASSERT_EQ (0, node.block_processor.size ());
+}
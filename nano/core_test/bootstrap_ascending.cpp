@@ -3,6 +3,7 @@
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/bootstrap_ascending/service.hpp>
 #include <nano/node/make_store.hpp>
+#include <nano/test_common/chains.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
 
@@ -256,6 +257,25 @@ TEST (bootstrap_ascending, trace_base)
 	ASSERT_TIMELY (10s, node1.block (receive1->hash ()) != nullptr);
 }
 
+/**
+ * Tests that several requesting threads bootstrap accounts spread over all priority shards
+ */
+TEST (bootstrap_ascending, many_accounts)
+{
+	nano::node_flags flags;
+	flags.disable_legacy_bootstrap = true;
+	nano::test::system system;
+	auto & node0 = *system.add_node (flags);
+	auto chains = nano::test::setup_chains (system, node0, 32, 4, nano::dev::genesis_key, /* do not confirm */ false);
+	nano::node_config config = system.default_config ();
+	config.bootstrap_ascending.threads = 4;
+	auto & node1 = *system.add_node (config, flags);
+	for (auto const & chain : chains)
+	{
+		ASSERT_TIMELY (30s, nano::test::exists (node1, chain.second));
+	}
+}
+
 TEST (bootstrap_ascending, config_serialization)
 {
 	nano::bootstrap_ascending_config config1;
@@ -266,6 +286,7 @@ TEST (bootstrap_ascending, config_serialization)
 	config1.throttle_coefficient = 0x105;
 	config1.throttle_wait = 0x106;
 	config1.block_wait_count = 0x107;
+	config1.threads = 0x108;
 	nano::tomlconfig toml1;
 	ASSERT_FALSE (config1.serialize (toml1));
 	std::stringstream stream1;
@@ -283,4 +304,5 @@ TEST (bootstrap_ascending, config_serialization)
 	ASSERT_EQ (config1.throttle_coefficient, config2.throttle_coefficient);
 	ASSERT_EQ (config1.throttle_wait, config2.throttle_wait);
 	ASSERT_EQ (config1.block_wait_count, config2.block_wait_count);
+	ASSERT_EQ (config1.threads, config2.threads);
 }
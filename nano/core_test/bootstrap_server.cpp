@@ -16,8 +16,21 @@ class responses_helper final
 public:
 	void add (nano::asc_pull_ack & ack)
 	{
+		// Keep the response as a peer would decode it, blocks are sent pre-serialized
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream{ bytes };
+			ack.serialize (stream);
+		}
+		nano::bufferstream stream{ bytes.data (), bytes.size () };
+		bool error = false;
+		nano::message_header header{ error, stream };
+		debug_assert (!error);
+		nano::asc_pull_ack decoded{ error, stream, header };
+		debug_assert (!error);
+
 		nano::lock_guard<nano::mutex> lock{ mutex };
-		responses.push_back (ack);
+		responses.push_back (decoded);
 	}
 
 	std::vector<nano::asc_pull_ack> get ()
@@ -1164,7 +1164,7 @@ TEST (confirmation_heightDeathTest, rollback_added_block)
 		ASSERT_TRUE (!store->init_error ());
 		nano::stats stats;
 		nano::ledger ledger (*store, stats, nano::dev::constants);
-		nano::write_database_queue write_database_queue (false);
+		nano::write_database_queue write_database_queue (false, stats);
 		nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		nano::keypair key1;
 		nano::block_builder builder;
@@ -1254,7 +1254,7 @@ TEST (confirmation_heightDeathTest, modified_chain)
 		ASSERT_TRUE (!store->init_error ());
 		nano::stats stats;
 		nano::ledger ledger (*store, stats, nano::dev::constants);
-		nano::write_database_queue write_database_queue (false);
+		nano::write_database_queue write_database_queue (false, stats);
 		nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		nano::keypair key1;
 		nano::block_builder builder;
@@ -1331,7 +1331,7 @@ TEST (confirmation_heightDeathTest, modified_chain_account_removed)
 		ASSERT_TRUE (!store->init_error ());
 		nano::stats stats;
 		nano::ledger ledger (*store, stats, nano::dev::constants);
-		nano::write_database_queue write_database_queue (false);
+		nano::write_database_queue write_database_queue (false, stats);
 		nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 		nano::keypair key1;
 		nano::block_builder builder;
@@ -2038,7 +2038,7 @@ TEST (confirmation_height, unbounded_block_cache_iteration)
 	ASSERT_TRUE (!store->init_error ());
 	nano::stats stats;
 	nano::ledger ledger (*store, stats, nano::dev::constants);
-	nano::write_database_queue write_database_queue (false);
+	nano::write_database_queue write_database_queue (false, stats);
 	boost::latch initialized_latch{ 0 };
 	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 	nano::keypair key1;
@@ -2093,6 +2093,152 @@ TEST (confirmation_height, unbounded_block_cache_iteration)
 	ASSERT_EQ (3, ledger.cache.cemented_count);
 }
 
+namespace nano
+{
+TEST (confirmation_height, discovery)
+{
+	nano::logger logger;
+	auto path (nano::unique_path ());
+	auto store = nano::make_store (logger, path, nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	nano::stats stats;
+	nano::ledger ledger (*store, stats, nano::dev::constants);
+	nano::write_database_queue write_database_queue (false, stats);
+	boost::latch initialized_latch{ 0 };
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::keypair key1;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .send ()
+				 .previous (nano::dev::genesis->hash ())
+				 .destination (key1.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (nano::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder
+				 .send ()
+				 .previous (send1->hash ())
+				 .destination (key1.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio * 2)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (send1->hash ()))
+				 .build_shared ();
+	auto open = builder
+				.open ()
+				.source (send1->hash ())
+				.representative (key1.pub)
+				.account (key1.pub)
+				.sign (key1.prv, key1.pub)
+				.work (*pool.generate (key1.pub))
+				.build_shared ();
+	auto receive = builder
+				   .receive ()
+				   .previous (open->hash ())
+				   .source (send2->hash ())
+				   .sign (key1.prv, key1.pub)
+				   .work (*pool.generate (open->hash ()))
+				   .build_shared ();
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, ledger.cache, nano::dev::constants);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send2).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *open).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *receive).code);
+	}
+
+	nano::confirmation_height_processor confirmation_height_processor (ledger, write_database_queue, 10ms, logger, initialized_latch, nano::confirmation_height_mode::automatic, 2);
+	nano::timer<> timer;
+	timer.start ();
+	confirmation_height_processor.pause ();
+	confirmation_height_processor.add (send1);
+	// Queued behind send1, so its chains are read ahead by the discovery threads: receive, open, send2 and send1
+	confirmation_height_processor.add (receive);
+	while (confirmation_height_processor.discovered < 4)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	ASSERT_EQ (4, confirmation_height_processor.discovered);
+
+	// Discovery does not cement anything by itself
+	ASSERT_EQ (1, ledger.cache.cemented_count);
+	confirmation_height_processor.unpause ();
+	while (ledger.cache.cemented_count < 5)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	ASSERT_EQ (4, stats.count (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed, nano::stat::dir::in));
+}
+
+// Blocks queued on the same account only read the part of the chain not already read for earlier ones
+TEST (confirmation_height, discovery_shared_walk)
+{
+	nano::logger logger;
+	auto path (nano::unique_path ());
+	auto store = nano::make_store (logger, path, nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	nano::stats stats;
+	nano::ledger ledger (*store, stats, nano::dev::constants);
+	nano::write_database_queue write_database_queue (false, stats);
+	boost::latch initialized_latch{ 0 };
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::keypair key1;
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> sends;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, ledger.cache, nano::dev::constants);
+		auto previous = nano::dev::genesis->hash ();
+		for (auto i = 1; i <= 4; ++i)
+		{
+			auto send = builder
+						.send ()
+						.previous (previous)
+						.destination (key1.pub)
+						.balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio * i)
+						.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+						.work (*pool.generate (previous))
+						.build_shared ();
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send).code);
+			previous = send->hash ();
+			sends.push_back (send);
+		}
+	}
+
+	nano::confirmation_height_processor confirmation_height_processor (ledger, write_database_queue, 10ms, logger, initialized_latch, nano::confirmation_height_mode::automatic, 1);
+	nano::timer<> timer;
+	timer.start ();
+	confirmation_height_processor.pause ();
+	for (auto const & send : sends)
+	{
+		confirmation_height_processor.add (send);
+	}
+	// Every block above the confirmation height is read exactly once, instead of once per queued block
+	while (confirmation_height_processor.discovered < 4)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	std::this_thread::sleep_for (100ms);
+	ASSERT_EQ (4, confirmation_height_processor.discovered);
+
+	confirmation_height_processor.unpause ();
+	while (ledger.cache.cemented_count < 5)
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+	// Cementing prunes the walked heights
+	auto walked_empty = [&confirmation_height_processor] () {
+		nano::lock_guard<nano::mutex> guard (confirmation_height_processor.discovery_mutex);
+		return confirmation_height_processor.discovery_walked.empty ();
+	};
+	while (!walked_empty ())
+	{
+		ASSERT_LT (timer.since_start (), 10s);
+	}
+}
+}
+
 TEST (confirmation_height, pruned_source)
 {
 	nano::logger logger;
@@ -2102,7 +2248,7 @@ TEST (confirmation_height, pruned_source)
 	nano::stats stats;
 	nano::ledger ledger (*store, stats, nano::dev::constants);
 	ledger.pruning = true;
-	nano::write_database_queue write_database_queue (false);
+	nano::write_database_queue write_database_queue (false, stats);
 	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
 	nano::keypair key1, key2;
 	nano::block_builder builder;
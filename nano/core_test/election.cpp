@@ -306,3 +306,64 @@ TEST (election, continuous_voting)
 	// Ensure votes are broadcasted in continuous manner
 	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::election, nano::stat::detail::broadcast_vote) >= 5);
 }
+
+/*
+ * Tallies follow a representative's vote as it moves between blocks and from normal to final
+ */
+TEST (election, tally_vote_moves)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.online_weight_minimum = nano::dev::constants.genesis_amount;
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	auto & node = *system.add_node (node_config);
+	nano::state_block_builder builder;
+
+	auto send1 = builder.make_block ()
+				 .previous (nano::dev::genesis->hash ())
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (node.online_reps.delta () - 1)
+				 .link (nano::keypair{}.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build_shared ();
+
+	auto send2 = builder.make_block ()
+				 .previous (nano::dev::genesis->hash ())
+				 .account (nano::dev::genesis_key.pub)
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (node.online_reps.delta () - 1)
+				 .link (nano::keypair{}.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .build_shared ();
+
+	node.process_active (send1);
+	ASSERT_TIMELY (5s, node.active.election (send1->qualified_root ()))
+	node.process_active (send2);
+	std::shared_ptr<nano::election> election;
+	ASSERT_TIMELY (5s, election = node.active.election (send2->qualified_root ()))
+	ASSERT_TIMELY_EQ (5s, election->blocks ().size (), 2);
+
+	auto const weight = node.ledger.weight (nano::dev::genesis_key.pub);
+
+	// Cached votes are not subject to the cooldown, so the vote can move right away
+	ASSERT_TRUE (election->vote (nano::dev::genesis_key.pub, 1, send1->hash (), nano::election::vote_source::cache).processed);
+	auto tally1 = election->tally ();
+	ASSERT_EQ (weight, tally1.begin ()->first);
+	ASSERT_EQ (send1->hash (), tally1.begin ()->second->hash ());
+
+	ASSERT_TRUE (election->vote (nano::dev::genesis_key.pub, 2, send2->hash (), nano::election::vote_source::cache).processed);
+	auto tally2 = election->tally ();
+	ASSERT_EQ (weight, tally2.begin ()->first);
+	ASSERT_EQ (send2->hash (), tally2.begin ()->second->hash ());
+	// Nothing is left of the earlier vote for send1
+	ASSERT_EQ (0, tally2.rbegin ()->first);
+
+	ASSERT_TRUE (election->vote (nano::dev::genesis_key.pub, std::numeric_limits<uint64_t>::max (), send2->hash (), nano::election::vote_source::cache).processed);
+	auto tally3 = election->tally ();
+	ASSERT_EQ (weight, tally3.begin ()->first);
+	ASSERT_EQ (weight, election->current_status ().status.final_tally);
+	ASSERT_FALSE (election->confirmed ());
+}
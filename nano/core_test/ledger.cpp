@@ -6,6 +6,7 @@
 #include <nano/node/scheduler/component.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/transport/inproc.hpp>
+#include <nano/store/delegator.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 #include <nano/test_common/ledger.hpp>
 #include <nano/test_common/system.hpp>
@@ -543,6 +544,56 @@ TEST (ledger, representative_change)
 	ASSERT_EQ (0, ledger.weight (key2.pub));
 }
 
+TEST (ledger, delegators_index)
+{
+	auto ctx = nano::test::context::ledger_empty ();
+	auto & ledger = ctx.ledger ();
+	auto & store = ctx.store ();
+	auto transaction = store.tx_begin_write ();
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ nano::dev::genesis_key.pub, nano::dev::genesis_key.pub }));
+	nano::block_builder builder;
+	auto send = builder
+				.state ()
+				.account (nano::dev::genesis_key.pub)
+				.previous (nano::dev::genesis->hash ())
+				.representative (key2.pub)
+				.balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				.link (key1.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*pool.generate (nano::dev::genesis->hash ()))
+				.build ();
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send).code);
+	auto open = builder
+				.state ()
+				.account (key1.pub)
+				.previous (0)
+				.representative (key2.pub)
+				.balance (nano::Gxrb_ratio)
+				.link (send->hash ())
+				.sign (key1.prv, key1.pub)
+				.work (*pool.generate (key1.pub))
+				.build ();
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *open).code);
+	// Representative changes move the entry, opening an account adds one
+	ASSERT_FALSE (store.delegator.exists (transaction, nano::delegator_key{ nano::dev::genesis_key.pub, nano::dev::genesis_key.pub }));
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ key2.pub, nano::dev::genesis_key.pub }));
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ key2.pub, key1.pub }));
+	std::vector<nano::account> delegators;
+	for (auto i (store.delegator.begin (transaction, nano::delegator_key{ key2.pub, 0 })), n (store.delegator.end ()); i != n && i->first.representative == key2.pub; ++i)
+	{
+		delegators.push_back (i->first.account);
+	}
+	ASSERT_EQ (2, delegators.size ());
+	// Rolling back the send also rolls back the open, removing the account
+	ASSERT_FALSE (ledger.rollback (transaction, send->hash ()));
+	ASSERT_FALSE (store.delegator.exists (transaction, nano::delegator_key{ key2.pub, key1.pub }));
+	ASSERT_FALSE (store.delegator.exists (transaction, nano::delegator_key{ key2.pub, nano::dev::genesis_key.pub }));
+	ASSERT_TRUE (store.delegator.exists (transaction, nano::delegator_key{ nano::dev::genesis_key.pub, nano::dev::genesis_key.pub }));
+}
+
 TEST (ledger, send_fork)
 {
 	auto ctx = nano::test::context::ledger_empty ();
@@ -684,6 +735,45 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+TEST (ledger, representation_snapshot)
+{
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::rep_weights rep_weights;
+	rep_weights.representation_put (key1.pub, 1);
+	auto snapshot1 = rep_weights.get_rep_amounts ();
+	ASSERT_EQ (1, snapshot1->size ());
+	// Snapshot is shared until weights change
+	ASSERT_EQ (snapshot1, rep_weights.get_rep_amounts ());
+	rep_weights.representation_add (key1.pub, 2);
+	rep_weights.representation_add (key2.pub, 5);
+	auto snapshot2 = rep_weights.get_rep_amounts ();
+	ASSERT_NE (snapshot1, snapshot2);
+	// Earlier snapshots are immutable
+	ASSERT_EQ (1, snapshot1->size ());
+	ASSERT_EQ (1, snapshot1->at (key1.pub));
+	ASSERT_EQ (2, snapshot2->size ());
+	ASSERT_EQ (3, snapshot2->at (key1.pub));
+	ASSERT_EQ (5, snapshot2->at (key2.pub));
+	ASSERT_EQ (3, rep_weights.representation_get (key1.pub));
+	ASSERT_EQ (5, rep_weights.representation_get (key2.pub));
+}
+
+TEST (ledger, representation_generation)
+{
+	nano::keypair key1;
+	nano::rep_weights rep_weights;
+	auto const generation1 = rep_weights.generation ();
+	ASSERT_EQ (generation1, rep_weights.generation ());
+	rep_weights.representation_add (key1.pub, 1);
+	auto const generation2 = rep_weights.generation ();
+	ASSERT_NE (generation1, generation2);
+	// Reads do not change the generation
+	ASSERT_EQ (1, rep_weights.representation_get (key1.pub));
+	rep_weights.get_rep_amounts ();
+	ASSERT_EQ (generation2, rep_weights.generation ());
+}
+
 TEST (ledger, representation)
 {
 	auto ctx = nano::test::context::ledger_empty ();
@@ -13,7 +13,8 @@ template <class message_type>
 auto message_deserializer_success_checker (message_type & message_original) -> void
 {
 	// Dependencies for the message deserializer.
-	nano::network_filter filter (1);
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
 	nano::block_uniquer block_uniquer;
 	nano::vote_uniquer vote_uniquer;
 
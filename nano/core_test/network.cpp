@@ -991,65 +991,158 @@ TEST (network, tcp_no_connect_excluded_peers)
 	ASSERT_TIMELY_EQ (5s, node0->network.size (), 1);
 }
 
-namespace nano
-{
 TEST (network, tcp_message_manager)
 {
-	nano::tcp_message_manager manager (1);
+	nano::stats stats;
+	nano::tcp_message_manager manager (stats, 4);
 	nano::tcp_message_item item;
 	item.node_id = nano::account (100);
-	ASSERT_EQ (0, manager.entries.size ());
-	manager.put_message (item);
-	ASSERT_EQ (1, manager.entries.size ());
+	ASSERT_EQ (0, manager.size ());
+	ASSERT_FALSE (manager.put_message (item));
+	ASSERT_EQ (1, manager.size ());
 	ASSERT_EQ (manager.get_message ().node_id, item.node_id);
-	ASSERT_EQ (0, manager.entries.size ());
+	ASSERT_EQ (0, manager.size ());
 
-	// Fill the queue
-	manager.entries = decltype (manager.entries) (manager.max_entries, item);
-	ASSERT_EQ (manager.entries.size (), manager.max_entries);
+	// Fill the queue of a single peer, further messages from it are dropped
+	for (auto i = 0; i < 4; ++i)
+	{
+		ASSERT_FALSE (manager.put_message (item));
+	}
+	ASSERT_TRUE (manager.put_message (item));
+	ASSERT_EQ (4, manager.size (item.endpoint));
+	ASSERT_EQ (1, stats.count (nano::stat::type::tcp_message_manager, nano::stat::detail::overfill));
+
+	// Another peer is not affected
+	nano::tcp_message_item other;
+	other.endpoint = nano::tcp_endpoint (boost::asio::ip::address_v6::loopback (), 1000);
+	other.node_id = nano::account (200);
+	ASSERT_FALSE (manager.put_message (other));
+	ASSERT_EQ (5, manager.size ());
+
+	// Peers are served round robin
+	ASSERT_EQ (manager.get_message ().node_id, item.node_id);
+	ASSERT_EQ (manager.get_message ().node_id, other.node_id);
+	ASSERT_EQ (0, manager.size (other.endpoint));
+	for (auto i = 0; i < 3; ++i)
+	{
+		ASSERT_EQ (manager.get_message ().node_id, item.node_id);
+	}
+	ASSERT_EQ (0, manager.size ());
 
-	// This task will wait until a message is consumed
+	// Blocked consumers are released on stop
 	auto future = std::async (std::launch::async, [&] {
-		manager.put_message (item);
+		return manager.get_message ();
 	});
-
-	// This should give sufficient time to execute put_message
-	// and prove that it waits on condition variable
-	std::this_thread::sleep_for (200ms);
-
-	ASSERT_EQ (manager.entries.size (), manager.max_entries);
-	ASSERT_EQ (manager.get_message ().node_id, item.node_id);
+	ASSERT_EQ (std::future_status::timeout, future.wait_for (100ms));
+	manager.stop ();
 	ASSERT_NE (std::future_status::timeout, future.wait_for (1s));
-	ASSERT_EQ (manager.entries.size (), manager.max_entries);
+	ASSERT_EQ (nullptr, future.get ().message);
 
-	nano::tcp_message_manager manager2 (2);
+	nano::tcp_message_manager manager2 (stats);
 	size_t message_count = 10'000;
+	std::atomic<size_t> consumed{ 0 };
 	std::vector<std::thread> consumers;
 	for (auto i = 0; i < 4; ++i)
 	{
 		consumers.emplace_back ([&] {
-			for (auto i = 0; i < message_count; ++i)
+			while (manager2.get_message ().node_id == item.node_id)
 			{
-				ASSERT_EQ (manager.get_message ().node_id, item.node_id);
+				++consumed;
 			}
 		});
 	}
 	std::vector<std::thread> producers;
 	for (auto i = 0; i < 4; ++i)
 	{
-		producers.emplace_back ([&] {
-			for (auto i = 0; i < message_count; ++i)
+		producers.emplace_back ([&, i] {
+			auto item_l = item;
+			item_l.endpoint = nano::tcp_endpoint (boost::asio::ip::address_v6::loopback (), 2000 + i);
+			for (auto j = 0; j < message_count; ++j)
 			{
-				manager.put_message (item);
+				while (manager2.put_message (item_l))
+				{
+					std::this_thread::yield ();
+				}
 			}
 		});
 	}
-
-	for (auto & t : boost::range::join (producers, consumers))
+	for (auto & t : producers)
+	{
+		t.join ();
+	}
+	auto deadline = std::chrono::steady_clock::now () + 10s;
+	while (consumed < 4 * message_count && std::chrono::steady_clock::now () < deadline)
+	{
+		std::this_thread::sleep_for (1ms);
+	}
+	manager2.stop ();
+	for (auto & t : consumers)
 	{
 		t.join ();
 	}
+	ASSERT_EQ (4 * message_count, consumed);
+}
+
+TEST (network, tcp_message_manager_priority)
+{
+	nano::stats stats;
+	nano::tcp_message_manager manager (stats);
+	nano::keypair key;
+	nano::tcp_message_item keepalive{ std::make_shared<nano::keepalive> (nano::dev::network_params.network), {}, 1, nullptr };
+	auto vote = std::make_shared<nano::vote> (key.pub, key.prv, 0, 0, std::vector<nano::block_hash>{ nano::dev::genesis->hash () });
+	nano::tcp_message_item confirm_ack{ std::make_shared<nano::confirm_ack> (nano::dev::network_params.network, vote), {}, 2, nullptr };
+	ASSERT_EQ (nano::tcp_message_manager::priority::normal, nano::tcp_message_manager::priority_of (keepalive));
+	ASSERT_EQ (nano::tcp_message_manager::priority::high, nano::tcp_message_manager::priority_of (confirm_ack));
+
+	ASSERT_FALSE (manager.put_message (keepalive));
+	for (auto i = 0; i < 8; ++i)
+	{
+		ASSERT_FALSE (manager.put_message (confirm_ack));
+	}
+	// Votes queued after the keepalive are served first, but the keepalive is not starved
+	for (auto i = 0; i < nano::tcp_message_manager::high_priority_ratio - 1; ++i)
+	{
+		ASSERT_EQ (2, manager.get_message ().node_id.number ());
+	}
+	ASSERT_EQ (1, manager.get_message ().node_id.number ());
+	ASSERT_EQ (8 - (nano::tcp_message_manager::high_priority_ratio - 1), manager.size ());
 }
+
+TEST (network, syn_cookies)
+{
+	nano::syn_cookies cookies (2);
+	nano::keypair key;
+	auto const address = boost::asio::ip::make_address_v6 ("::ffff:10.0.0.1");
+	nano::endpoint endpoint1 (address, 1000);
+	nano::endpoint endpoint2 (address, 1001);
+	nano::endpoint endpoint3 (address, 1002);
+	auto cookie1 = cookies.assign (endpoint1);
+	ASSERT_TRUE (cookie1);
+	// Only one cookie per endpoint
+	ASSERT_FALSE (cookies.assign (endpoint1));
+	ASSERT_TRUE (cookies.assign (endpoint2));
+	// Per IP limit reached
+	ASSERT_FALSE (cookies.assign (endpoint3));
+	ASSERT_EQ (2, cookies.cookies_size ());
+
+	// Other addresses land in other shards and are not affected by the limit
+	for (auto i = 2; i < 34; ++i)
+	{
+		nano::endpoint other (boost::asio::ip::make_address_v6 ("::ffff:10.0.1." + std::to_string (i)), 1000);
+		ASSERT_TRUE (cookies.assign (other));
+	}
+	ASSERT_EQ (34, cookies.cookies_size ());
+
+	// A wrong signature leaves the cookie in place
+	ASSERT_TRUE (cookies.validate (endpoint1, key.pub, nano::sign_message (key.prv, key.pub, nano::uint256_union{ 1 })));
+	ASSERT_FALSE (cookies.validate (endpoint1, key.pub, nano::sign_message (key.prv, key.pub, *cookie1)));
+	// Cookies are single use and free up the per IP slot
+	ASSERT_TRUE (cookies.validate (endpoint1, key.pub, nano::sign_message (key.prv, key.pub, *cookie1)));
+	ASSERT_EQ (33, cookies.cookies_size ());
+	ASSERT_TRUE (cookies.assign (endpoint3));
+
+	cookies.purge (std::chrono::steady_clock::now ());
+	ASSERT_EQ (0, cookies.cookies_size ());
 }
 
 TEST (network, cleanup_purge)
@@ -1,3 +1,4 @@
+#include <nano/lib/stats.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/node/common.hpp>
 #include <nano/secure/common.hpp>
@@ -6,9 +7,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cryptopp/siphash.h>
+
 TEST (network_filter, unit)
 {
-	nano::network_filter filter (1);
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
 	auto one_block = [&filter] (std::shared_ptr<nano::block> const & block_a, bool expect_duplicate_a) {
 		nano::publish message{ nano::dev::network_params.network, block_a };
 		auto bytes (message.to_bytes ());
@@ -61,7 +65,8 @@ TEST (network_filter, unit)
 
 TEST (network_filter, many)
 {
-	nano::network_filter filter (4);
+	nano::stats stats;
+	nano::network_filter filter (4, stats);
 	nano::keypair key1;
 	for (int i = 0; i < 100; ++i)
 	{
@@ -102,7 +107,8 @@ TEST (network_filter, many)
 
 TEST (network_filter, clear)
 {
-	nano::network_filter filter (1);
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
 	std::vector<uint8_t> bytes1{ 1, 2, 3 };
 	std::vector<uint8_t> bytes2{ 1 };
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
@@ -117,7 +123,8 @@ TEST (network_filter, clear)
 
 TEST (network_filter, optional_digest)
 {
-	nano::network_filter filter (1);
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
 	std::vector<uint8_t> bytes1{ 1, 2, 3 };
 	nano::uint128_t digest{ 0 };
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size (), &digest));
@@ -126,3 +133,72 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+TEST (network_filter, batch)
+{
+	nano::stats stats;
+	nano::network_filter filter (1024, stats);
+	std::vector<uint8_t> bytes1{ 1, 2, 3 };
+	std::vector<uint8_t> bytes2{ 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+	std::vector<uint8_t> bytes3{ 13 };
+	ASSERT_FALSE (filter.apply (bytes2.data (), bytes2.size ()));
+	std::vector<std::pair<uint8_t const *, size_t>> messages{
+		{ bytes1.data (), bytes1.size () },
+		{ bytes2.data (), bytes2.size () },
+		{ bytes1.data (), bytes1.size () },
+		{ bytes3.data (), bytes3.size () }
+	};
+	std::vector<nano::uint128_t> digests;
+	auto result = filter.apply (messages, &digests);
+	ASSERT_EQ ((std::vector<bool>{ false, true, true, false }), result);
+	ASSERT_EQ (4, digests.size ());
+	ASSERT_EQ (digests[0], digests[2]);
+	nano::uint128_t digest3{ 0 };
+	ASSERT_TRUE (filter.apply (bytes3.data (), bytes3.size (), &digest3));
+	ASSERT_EQ (digest3, digests[3]);
+	filter.clear (digests);
+	ASSERT_EQ ((std::vector<bool>{ false, false, true, false }), filter.apply (messages));
+}
+
+TEST (network_filter, stats)
+{
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
+	std::vector<uint8_t> bytes1{ 1, 2, 3 };
+	std::vector<uint8_t> bytes2{ 1 };
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_TRUE (filter.apply (bytes1.data (), bytes1.size ()));
+	// Single element filter, the second digest evicts the first one
+	ASSERT_FALSE (filter.apply (bytes2.data (), bytes2.size ()));
+	ASSERT_EQ (1, stats.count (nano::stat::type::filter, nano::stat::detail::hit));
+	ASSERT_EQ (2, stats.count (nano::stat::type::filter, nano::stat::detail::miss));
+	ASSERT_EQ (1, stats.count (nano::stat::type::filter, nano::stat::detail::collision));
+}
+
+namespace nano
+{
+// The inlined hash must produce the same digests as the reference CryptoPP implementation
+TEST (network_filter, siphash)
+{
+	nano::stats stats;
+	nano::network_filter filter (1, stats);
+	CryptoPP::SecByteBlock key (16);
+	for (auto i = 0; i < 8; ++i)
+	{
+		key[i] = static_cast<uint8_t> (filter.key[0] >> (8 * i));
+		key[8 + i] = static_cast<uint8_t> (filter.key[1] >> (8 * i));
+	}
+	std::vector<uint8_t> bytes (300);
+	for (size_t i = 0; i < bytes.size (); ++i)
+	{
+		bytes[i] = static_cast<uint8_t> (i * 31 + 7);
+	}
+	for (auto size : { 0, 1, 7, 8, 9, 15, 16, 17, 216, 300 })
+	{
+		nano::uint128_union expected;
+		CryptoPP::SipHash<2, 4, true> siphash (key, static_cast<unsigned int> (key.size ()));
+		siphash.CalculateDigest (expected.bytes.data (), bytes.data (), size);
+		ASSERT_EQ (expected.number (), filter.hash (bytes.data (), size));
+	}
+}
+}
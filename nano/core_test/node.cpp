@@ -1972,6 +1972,38 @@ TEST (node, stat_counting)
 	ASSERT_EQ (10, node1.stats.count (nano::stat::type::ledger, nano::stat::dir::in));
 }
 
+TEST (node, stat_counting_threads)
+{
+	nano::stats stats;
+	std::vector<std::pair<uint64_t, uint64_t>> observed;
+	stats.observe_count (nano::stat::type::ledger, nano::stat::detail::receive, nano::stat::dir::in, [&observed] (uint64_t old_value, uint64_t new_value) {
+		observed.emplace_back (old_value, new_value);
+	});
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < 8; ++i)
+	{
+		threads.emplace_back ([&stats] () {
+			for (auto j = 0; j < 1000; ++j)
+			{
+				stats.inc (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (8000, stats.count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in));
+	ASSERT_EQ (8000, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+	stats.add (nano::stat::type::ledger, nano::stat::detail::receive, nano::stat::dir::in, 3);
+	ASSERT_EQ (1, observed.size ());
+	ASSERT_EQ (0, observed.front ().first);
+	ASSERT_EQ (3, observed.front ().second);
+	stats.clear ();
+	ASSERT_EQ (0, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+	ASSERT_EQ (0, stats.count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in));
+}
+
 TEST (node, stat_histogram)
 {
 	nano::test::system system (1);
@@ -3065,6 +3097,33 @@ TEST (node, block_processor_half_full)
 	ASSERT_FALSE (node.block_processor.full ());
 }
 
+// Writers following each other in the queue share a single flush at the end of their group
+TEST (node, write_database_queue_group_commit)
+{
+	nano::stats stats;
+	nano::write_database_queue queue (false, stats);
+	std::atomic<int> flushes{ 0 };
+	bool deferred{ false };
+	queue.enable_group_commit ([&flushes] () { ++flushes; }, [&deferred] (bool defer) { deferred = defer; });
+	auto guard1 = queue.wait (nano::writer::testing);
+	// Commits made while holding the turn are left to the group flush
+	ASSERT_TRUE (deferred);
+	// Queues another writer behind the current one
+	ASSERT_FALSE (queue.process (nano::writer::process_batch));
+	guard1.release ();
+	ASSERT_FALSE (deferred);
+	ASSERT_EQ (0, flushes);
+	{
+		auto guard2 = queue.wait (nano::writer::process_batch);
+		ASSERT_TRUE (deferred);
+	}
+	ASSERT_FALSE (deferred);
+	ASSERT_EQ (1, flushes);
+	ASSERT_EQ (1, stats.count (nano::stat::type::write_queue, nano::stat::detail::flush));
+	ASSERT_EQ (1, stats.count (nano::stat::type::write_queue, nano::stat::detail::testing));
+	ASSERT_EQ (1, stats.count (nano::stat::type::write_queue, nano::stat::detail::process_batch));
+}
+
 TEST (node, confirm_back)
 {
 	nano::test::system system (1);
@@ -518,3 +518,61 @@ TEST (request_aggregator, cannot_vote)
 	ASSERT_TIMELY (3s, 1 <= node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 }
 }
+
+namespace
+{
+uint64_t latency_count (nano::node & node)
+{
+	uint64_t result = 0;
+	for (auto detail : { nano::stat::detail::aggregator_latency_under_10ms, nano::stat::detail::aggregator_latency_under_25ms, nano::stat::detail::aggregator_latency_under_50ms, nano::stat::detail::aggregator_latency_under_100ms, nano::stat::detail::aggregator_latency_under_200ms, nano::stat::detail::aggregator_latency_under_300ms, nano::stat::detail::aggregator_latency_under_500ms, nano::stat::detail::aggregator_latency_under_1s, nano::stat::detail::aggregator_latency_over_1s })
+	{
+		result += node.stats.count (nano::stat::type::aggregator, detail);
+	}
+	return result;
+}
+}
+
+TEST (request_aggregator, latency)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.request_aggregator_threads = 2;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	std::vector<std::pair<nano::block_hash, nano::root>> request;
+	request.emplace_back (nano::dev::genesis->hash (), nano::dev::genesis->root ());
+	auto client = std::make_shared<nano::transport::socket> (node);
+	std::shared_ptr<nano::transport::channel> dummy_channel = std::make_shared<nano::transport::channel_tcp> (node, client);
+	node.aggregator.add (dummy_channel, request);
+	ASSERT_TIMELY (3s, node.aggregator.empty ());
+	// Every processed pool is counted in one of the latency buckets
+	ASSERT_TIMELY_EQ (3s, 1, latency_count (node));
+	// Pools are held for at least small_delay, which is 10ms on the dev network
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_latency_under_10ms));
+}
+
+/*
+ * Clearing stats must not break latency accounting for pools processed afterwards
+ */
+TEST (request_aggregator, latency_after_stats_clear)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.request_aggregator_threads = 2;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	std::vector<std::pair<nano::block_hash, nano::root>> request;
+	request.emplace_back (nano::dev::genesis->hash (), nano::dev::genesis->root ());
+	auto client = std::make_shared<nano::transport::socket> (node);
+	std::shared_ptr<nano::transport::channel> dummy_channel = std::make_shared<nano::transport::channel_tcp> (node, client);
+	node.aggregator.add (dummy_channel, request);
+	ASSERT_TIMELY (3s, node.aggregator.empty ());
+	ASSERT_TIMELY_EQ (3s, 1, latency_count (node));
+	node.stats.clear ();
+	ASSERT_EQ (0, latency_count (node));
+	node.aggregator.add (dummy_channel, request);
+	ASSERT_TIMELY (3s, node.aggregator.empty ());
+	ASSERT_TIMELY_EQ (3s, 1, latency_count (node));
+}
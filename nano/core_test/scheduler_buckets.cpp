@@ -3,7 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 nano::keypair & keyzero ()
 {
@@ -129,7 +132,7 @@ TEST (buckets, index_max)
 TEST (buckets, insert_Gxrb)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
 	ASSERT_EQ (1, buckets.bucket_size (48));
 }
@@ -137,7 +140,7 @@ TEST (buckets, insert_Gxrb)
 TEST (buckets, insert_Mxrb)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block1 (), nano::Mxrb_ratio);
+	buckets.push (1000, block1 ()->hash (), nano::Mxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
 	ASSERT_EQ (1, buckets.bucket_size (13));
 }
@@ -146,8 +149,8 @@ TEST (buckets, insert_Mxrb)
 TEST (buckets, insert_same_priority)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1000, block2 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1000, block2 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (2, buckets.size ());
 	ASSERT_EQ (2, buckets.bucket_size (48));
 }
@@ -156,8 +159,8 @@ TEST (buckets, insert_same_priority)
 TEST (buckets, insert_duplicate)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
 	ASSERT_EQ (1, buckets.bucket_size (48));
 }
@@ -165,11 +168,11 @@ TEST (buckets, insert_duplicate)
 TEST (buckets, insert_older)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1100, block2 (), nano::Gxrb_ratio);
-	ASSERT_EQ (block0 (), buckets.top ());
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1100, block2 ()->hash (), nano::Gxrb_ratio);
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 	buckets.pop ();
-	ASSERT_EQ (block2 (), buckets.top ());
+	ASSERT_EQ (block2 ()->hash (), buckets.top ());
 	buckets.pop ();
 }
 
@@ -177,7 +180,7 @@ TEST (buckets, pop)
 {
 	nano::scheduler::buckets buckets;
 	ASSERT_TRUE (buckets.empty ());
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_FALSE (buckets.empty ());
 	buckets.pop ();
 	ASSERT_TRUE (buckets.empty ());
@@ -186,18 +189,18 @@ TEST (buckets, pop)
 TEST (buckets, top_one)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	ASSERT_EQ (block0 (), buckets.top ());
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 }
 
 TEST (buckets, top_two)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1, block1 (), nano::Mxrb_ratio);
-	ASSERT_EQ (block0 (), buckets.top ());
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1, block1 ()->hash (), nano::Mxrb_ratio);
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 	buckets.pop ();
-	ASSERT_EQ (block1 (), buckets.top ());
+	ASSERT_EQ (block1 ()->hash (), buckets.top ());
 	buckets.pop ();
 	ASSERT_TRUE (buckets.empty ());
 }
@@ -205,17 +208,17 @@ TEST (buckets, top_two)
 TEST (buckets, top_round_robin)
 {
 	nano::scheduler::buckets buckets;
-	buckets.push (1000, blockzero (), 0);
-	ASSERT_EQ (blockzero (), buckets.top ());
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1000, block1 (), nano::Mxrb_ratio);
-	buckets.push (1100, block3 (), nano::Mxrb_ratio);
+	buckets.push (1000, blockzero ()->hash (), 0);
+	ASSERT_EQ (blockzero ()->hash (), buckets.top ());
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1000, block1 ()->hash (), nano::Mxrb_ratio);
+	buckets.push (1100, block3 ()->hash (), nano::Mxrb_ratio);
 	buckets.pop (); // blockzero
-	EXPECT_EQ (block1 (), buckets.top ());
+	EXPECT_EQ (block1 ()->hash (), buckets.top ());
 	buckets.pop ();
-	EXPECT_EQ (block0 (), buckets.top ());
+	EXPECT_EQ (block0 ()->hash (), buckets.top ());
 	buckets.pop ();
-	EXPECT_EQ (block3 (), buckets.top ());
+	EXPECT_EQ (block3 ()->hash (), buckets.top ());
 	buckets.pop ();
 	EXPECT_TRUE (buckets.empty ());
 }
@@ -223,31 +226,87 @@ TEST (buckets, top_round_robin)
 TEST (buckets, trim_normal)
 {
 	nano::scheduler::buckets buckets{ 1 };
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1100, block2 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1100, block2 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
-	ASSERT_EQ (block0 (), buckets.top ());
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 }
 
 TEST (buckets, trim_reverse)
 {
 	nano::scheduler::buckets buckets{ 1 };
-	buckets.push (1100, block2 (), nano::Gxrb_ratio);
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
+	buckets.push (1100, block2 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
-	ASSERT_EQ (block0 (), buckets.top ());
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 }
 
 TEST (buckets, trim_even)
 {
 	nano::scheduler::buckets buckets{ 2 };
-	buckets.push (1000, block0 (), nano::Gxrb_ratio);
-	buckets.push (1100, block2 (), nano::Gxrb_ratio);
+	buckets.push (1000, block0 ()->hash (), nano::Gxrb_ratio);
+	buckets.push (1100, block2 ()->hash (), nano::Gxrb_ratio);
 	ASSERT_EQ (1, buckets.size ());
-	ASSERT_EQ (block0 (), buckets.top ());
-	buckets.push (1000, block1 (), nano::Mxrb_ratio);
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
+	buckets.push (1000, block1 ()->hash (), nano::Mxrb_ratio);
 	ASSERT_EQ (2, buckets.size ());
-	ASSERT_EQ (block0 (), buckets.top ());
+	ASSERT_EQ (block0 ()->hash (), buckets.top ());
 	buckets.pop ();
-	ASSERT_EQ (block1 (), buckets.top ());
+	ASSERT_EQ (block1 ()->hash (), buckets.top ());
+}
+
+// The bucket lookup narrowed by the leading bit of the balance must stay ordered across all thresholds
+TEST (buckets, index_thresholds)
+{
+	nano::scheduler::buckets buckets;
+	std::vector<nano::uint128_t> balances;
+	for (auto bit = 0; bit < 128; ++bit)
+	{
+		nano::uint128_t const value = nano::uint128_t{ 1 } << bit;
+		balances.push_back (value - 1);
+		balances.push_back (value);
+		balances.push_back (value + (value >> 1));
+	}
+	std::sort (balances.begin (), balances.end ());
+	std::size_t previous = 0;
+	for (auto const & balance : balances)
+	{
+		auto const index = buckets.index (balance);
+		ASSERT_LT (index, buckets.bucket_count ());
+		ASSERT_GE (index, previous);
+		previous = index;
+	}
+	ASSERT_EQ (0, buckets.index ((nano::uint128_t{ 1 } << 88) - 1));
+	ASSERT_EQ (1, buckets.index (nano::uint128_t{ 1 } << 88));
+	ASSERT_EQ (buckets.bucket_count () - 2, buckets.index ((nano::uint128_t{ 1 } << 120) - 1));
+	ASSERT_EQ (buckets.bucket_count () - 1, buckets.index (nano::uint128_t{ 1 } << 120));
+}
+
+TEST (buckets, push_concurrent)
+{
+	nano::scheduler::buckets buckets;
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < 4; ++i)
+	{
+		threads.emplace_back ([&buckets, i] () {
+			for (uint64_t j = 0; j < 1000; ++j)
+			{
+				buckets.push (j, nano::block_hash{ i * 1000 + j + 1 }, nano::amount{ nano::Gxrb_ratio * (i + 1) });
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (4000, buckets.size ());
+	std::unordered_set<nano::block_hash> popped;
+	while (!buckets.empty ())
+	{
+		auto hash = buckets.pop ();
+		ASSERT_TRUE (hash);
+		popped.insert (*hash);
+	}
+	ASSERT_EQ (4000, popped.size ());
+	ASSERT_FALSE (buckets.pop ());
 }
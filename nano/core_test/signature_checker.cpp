@@ -0,0 +1,88 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/node/signatures.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+nano::signature_check_set make_set (std::size_t count)
+{
+	nano::signature_check_set set;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		nano::keypair key;
+		nano::uint256_union message{ i };
+		set.add (key.pub, message, nano::sign_message (key.prv, key.pub, message));
+	}
+	return set;
+}
+}
+
+TEST (signature_checker, verify_empty)
+{
+	nano::test::system system;
+	nano::signature_checker checker{ system.stats, 0 };
+	nano::signature_check_set set;
+	checker.verify (set);
+	ASSERT_TRUE (set.verifications.empty ());
+}
+
+TEST (signature_checker, verify_invalid)
+{
+	nano::test::system system;
+	nano::signature_checker checker{ system.stats, 0 };
+	// Larger than a single batch
+	auto set = make_set (nano::signature_checker::batch_size + 3);
+	set.signatures[1].bytes[32] ^= 1;
+	set.messages[nano::signature_checker::batch_size + 1] = 42;
+	checker.verify (set);
+	for (std::size_t i = 0; i < set.size (); ++i)
+	{
+		ASSERT_EQ (i != 1 && i != nano::signature_checker::batch_size + 1, set.valid (i));
+	}
+	ASSERT_EQ (2, system.stats.count (nano::stat::type::signature_checker, nano::stat::detail::invalid, nano::stat::dir::in));
+}
+
+TEST (signature_checker, add_callback)
+{
+	nano::test::system system;
+	nano::signature_checker checker{ system.stats, 4, 2 };
+	std::atomic<std::size_t> valid{ 0 };
+	std::atomic<std::size_t> callbacks{ 0 };
+	std::size_t const count = 16;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto set = make_set (8);
+		set.signatures[0].bytes[0] ^= 1;
+		ASSERT_FALSE (checker.add (std::move (set), [&] (nano::signature_check_set & set) {
+			for (std::size_t j = 0; j < set.size (); ++j)
+			{
+				valid += set.valid (j);
+			}
+			++callbacks;
+		}));
+	}
+	ASSERT_TIMELY_EQ (5s, callbacks, count);
+	ASSERT_EQ (valid, count * 7);
+	checker.stop ();
+}
+
+TEST (signature_checker, stop)
+{
+	nano::test::system system;
+	nano::signature_checker checker{ system.stats, 2 };
+	std::promise<void> done;
+	ASSERT_FALSE (checker.add (make_set (4), [&] (nano::signature_check_set &) { done.set_value (); }));
+	checker.stop ();
+	// Sets queued before stopping are still verified
+	ASSERT_EQ (std::future_status::ready, done.get_future ().wait_for (0s));
+	ASSERT_TRUE (checker.add (make_set (4), [] (nano::signature_check_set &) { FAIL (); }));
+}
@@ -566,6 +566,70 @@ TEST (socket, concurrent_writes)
 	}
 }
 
+/**
+ * Queues more messages than fit into a single batched write and checks that they arrive intact and in order,
+ * with each write callback receiving the size of its own message
+ */
+TEST (socket, write_batch)
+{
+	nano::test::system system;
+
+	auto node_flags = nano::inactive_node_flag_defaults ();
+	node_flags.read_only = false;
+	nano::inactive_node inactivenode (nano::unique_path (), node_flags);
+	auto node = inactivenode.node;
+
+	nano::thread_runner runner (node->io_ctx, 1);
+
+	constexpr std::size_t message_count = nano::transport::socket::max_write_batch * 3;
+	constexpr std::size_t message_size = 2;
+
+	auto received = std::make_shared<std::vector<uint8_t>> (message_count * message_size);
+	std::atomic<bool> read_done{ false };
+	std::vector<std::shared_ptr<nano::transport::socket>> connections;
+	auto listener = std::make_shared<nano::transport::tcp_listener> (system.get_available_port (), *node, 1);
+	listener->start ([&connections, &received, &read_done] (std::shared_ptr<nano::transport::socket> const & new_connection, boost::system::error_code const & ec_a) {
+		connections.push_back (new_connection);
+		new_connection->async_read (received, received->size (), [&read_done] (boost::system::error_code const & ec, std::size_t size_a) {
+			read_done = !ec;
+		});
+		return true;
+	});
+
+	auto client = std::make_shared<nano::transport::socket> (*node);
+	std::atomic<bool> connected{ false };
+	client->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), listener->endpoint ().port ()), [&connected] (boost::system::error_code const & ec_a) {
+		connected = !ec_a;
+	});
+	ASSERT_TIMELY (5s, connected);
+
+	nano::test::counted_completion write_completion (static_cast<unsigned> (message_count));
+	std::atomic<std::size_t> written{ 0 };
+	for (std::size_t i = 0; i < message_count; ++i)
+	{
+		std::vector<uint8_t> buff{ static_cast<uint8_t> (i), static_cast<uint8_t> (i >> 8) };
+		client->async_write (nano::shared_const_buffer (std::move (buff)), [&write_completion, &written] (boost::system::error_code const & ec, std::size_t size_a) {
+			if (!ec)
+			{
+				written += size_a;
+			}
+			write_completion.increment ();
+		});
+	}
+	ASSERT_FALSE (write_completion.await_count_for (5s));
+	ASSERT_EQ (message_count * message_size, written);
+	ASSERT_TIMELY (5s, read_done);
+	for (std::size_t i = 0; i < message_count; ++i)
+	{
+		ASSERT_EQ (static_cast<uint8_t> (i), (*received)[i * message_size]);
+		ASSERT_EQ (static_cast<uint8_t> (i >> 8), (*received)[i * message_size + 1]);
+	}
+
+	node->stop ();
+	runner.stop_event_processing ();
+	runner.join ();
+}
+
 /**
  * Check that the socket correctly handles a tcp_io_timeout during tcp connect
  * Steps:
@@ -276,3 +276,130 @@ TEST (unchecked, multiple_get)
 	auto unchecked5 = unchecked.get (block2->hash ());
 	ASSERT_EQ (unchecked5.size (), 0);
 }
+
+// Putting an existing entry again refreshes it so that the oldest untouched entry is evicted first
+TEST (unchecked_map, eviction_order)
+{
+	nano::stats stats;
+	nano::unchecked_map unchecked{ 2, stats, false };
+	nano::block_builder builder;
+	auto make_block = [&builder] (uint64_t previous) {
+		return builder.send ()
+		.previous (previous)
+		.destination (1)
+		.balance (2)
+		.sign (nano::keypair ().prv, 4)
+		.work (5)
+		.build_shared ();
+	};
+	auto block1 = make_block (1);
+	auto block2 = make_block (2);
+	auto block3 = make_block (3);
+	unchecked.put (block1->previous (), nano::unchecked_info{ block1 });
+	unchecked.put (block2->previous (), nano::unchecked_info{ block2 });
+	unchecked.put (block1->previous (), nano::unchecked_info{ block1 });
+	unchecked.put (block3->previous (), nano::unchecked_info{ block3 });
+	ASSERT_EQ (2, unchecked.count ());
+	ASSERT_TRUE (unchecked.exists ({ block1->previous (), block1->hash () }));
+	ASSERT_FALSE (unchecked.exists ({ block2->previous (), block2->hash () }));
+	ASSERT_TRUE (unchecked.exists ({ block3->previous (), block3->hash () }));
+}
+
+// Entries are evicted once the memory budget is exceeded even if the entry count is not reached
+TEST (unchecked_map, eviction_memory)
+{
+	nano::stats stats;
+	nano::block_builder builder;
+	auto make_block = [&builder] (uint64_t previous) {
+		return builder.send ()
+		.previous (previous)
+		.destination (1)
+		.balance (2)
+		.sign (nano::keypair ().prv, 4)
+		.work (5)
+		.build_shared ();
+	};
+	auto block1 = make_block (1);
+	auto block2 = make_block (2);
+	auto block3 = make_block (3);
+	std::size_t entry_memory;
+	{
+		nano::unchecked_map sizing{ max_unchecked_blocks, stats, false };
+		sizing.put (block1->previous (), nano::unchecked_info{ block1 });
+		entry_memory = sizing.memory ();
+	}
+	ASSERT_GT (entry_memory, 0);
+	nano::unchecked_map unchecked{ max_unchecked_blocks, stats, false, 2 * entry_memory };
+	unchecked.put (block1->previous (), nano::unchecked_info{ block1 });
+	unchecked.put (block2->previous (), nano::unchecked_info{ block2 });
+	unchecked.put (block3->previous (), nano::unchecked_info{ block3 });
+	ASSERT_EQ (2, unchecked.count ());
+	ASSERT_EQ (2 * entry_memory, unchecked.memory ());
+	ASSERT_FALSE (unchecked.exists ({ block1->previous (), block1->hash () }));
+	ASSERT_TRUE (unchecked.exists ({ block2->previous (), block2->hash () }));
+	ASSERT_TRUE (unchecked.exists ({ block3->previous (), block3->hash () }));
+	unchecked.del ({ block2->previous (), block2->hash () });
+	ASSERT_EQ (entry_memory, unchecked.memory ());
+}
+
+// Removing the entry an iteration stopped at does not end the iteration early
+TEST (unchecked_map, for_each_concurrent_removal)
+{
+	nano::stats stats;
+	nano::unchecked_map unchecked{ max_unchecked_blocks, stats, false };
+	nano::block_builder builder;
+	std::size_t const total = 3 * 256;
+	for (uint64_t i = 0; i < total; ++i)
+	{
+		auto block = builder.send ()
+					 .previous (i + 1)
+					 .destination (1)
+					 .balance (2)
+					 .sign (nano::keypair ().prv, 4)
+					 .work (5)
+					 .build_shared ();
+		unchecked.put (block->previous (), nano::unchecked_info{ block });
+	}
+	std::size_t visited = 0;
+	unchecked.for_each ([&] (nano::unchecked_key const & key, nano::unchecked_info const &) {
+		++visited;
+		// Removes every entry as it is visited, including the last entry of each chunk
+		unchecked.del (key);
+	});
+	ASSERT_EQ (total, visited);
+	ASSERT_EQ (0, unchecked.count ());
+	ASSERT_EQ (0, unchecked.memory ());
+}
+
+// Every entry depending on a triggered dependency is released and removed, batched per notification
+TEST (unchecked_map, trigger_batch)
+{
+	nano::stats stats;
+	nano::unchecked_map unchecked{ max_unchecked_blocks, stats, false };
+	nano::block_builder builder;
+	auto make_block = [&builder] (nano::block_hash const & previous) {
+		return builder.send ()
+		.previous (previous)
+		.destination (1)
+		.balance (2)
+		.sign (nano::keypair ().prv, 4)
+		.work (5)
+		.build_shared ();
+	};
+	auto block1 = make_block (1);
+	auto block2 = make_block (1);
+	auto block3 = make_block (block1->hash ());
+	unchecked.put (block1->previous (), nano::unchecked_info{ block1 });
+	unchecked.put (block2->previous (), nano::unchecked_info{ block2 });
+	unchecked.put (block3->previous (), nano::unchecked_info{ block3 });
+	std::atomic<std::size_t> released{ 0 };
+	unchecked.satisfied.add ([&released] (std::deque<nano::unchecked_info> const & infos) {
+		released += infos.size ();
+	});
+	unchecked.trigger (block1->previous ());
+	unchecked.trigger (block1->hash ());
+	unchecked.flush ();
+	ASSERT_EQ (3, released);
+	ASSERT_EQ (0, unchecked.count ());
+	ASSERT_EQ (3, stats.count (nano::stat::type::unchecked, nano::stat::detail::satisfied));
+}
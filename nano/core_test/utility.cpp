@@ -1,3 +1,4 @@
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/optional_ptr.hpp>
 #include <nano/lib/rate_limiting.hpp>
 #include <nano/lib/thread_pool.hpp>
@@ -8,9 +9,11 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
 
 #include <fstream>
 #include <future>
+#include <sstream>
 
 using namespace std::chrono_literals;
 
@@ -346,3 +349,49 @@ TEST (relaxed_atomic_integral, many_threads)
 	// Check values
 	ASSERT_EQ (0, atomic);
 }
+
+TEST (json_writer, matches_ptree)
+{
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.put ("deprecated", "1");
+	writer.begin_object ("accounts");
+	writer.begin_object ("first");
+	writer.put ("balance", "100");
+	writer.put ("text", "quote \" backslash \\ newline \n control \x01");
+	writer.end_object ();
+	ASSERT_EQ (1, writer.count ());
+	writer.begin_array ("hashes");
+	writer.put ("a");
+	writer.put ("b");
+	writer.end_array ();
+	writer.begin_object ("empty");
+	writer.end_object ();
+	writer.end_object ();
+	writer.end_object ();
+	auto text (writer.release ());
+
+	boost::property_tree::ptree expected;
+	expected.put ("deprecated", "1");
+	boost::property_tree::ptree accounts;
+	boost::property_tree::ptree first;
+	first.put ("balance", "100");
+	first.put ("text", "quote \" backslash \\ newline \n control \x01");
+	accounts.add_child ("first", first);
+	boost::property_tree::ptree hashes;
+	for (auto hash : { "a", "b" })
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("", hash);
+		hashes.push_back (std::make_pair ("", entry));
+	}
+	accounts.add_child ("hashes", hashes);
+	accounts.add_child ("empty", boost::property_tree::ptree{});
+	expected.add_child ("accounts", accounts);
+
+	boost::property_tree::ptree parsed;
+	std::stringstream stream (text);
+	boost::property_tree::read_json (stream, parsed);
+	ASSERT_EQ (expected, parsed);
+	ASSERT_NE (std::string::npos, text.find ("\"empty\":\"\""));
+}
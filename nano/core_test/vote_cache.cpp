@@ -382,4 +382,51 @@ TEST (vote_cache, age_cutoff)
 
 	// After 3 seconds the entry should be removed
 	ASSERT_TIMELY (5s, vote_cache.top (0).empty ());
-}
\ No newline at end of file
+}
+
+/*
+ * Ensure that top entries stay correct once there are more entries than tracked per shard
+ */
+TEST (vote_cache, top_overflow)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = rep_weight_query ();
+	auto rep1 = create_rep (1);
+	auto rep2 = create_rep (5);
+	std::vector<nano::block_hash> low;
+	for (int n = 0; n < 32 * 1024; ++n)
+	{
+		auto vote = nano::test::make_vote (rep1, { nano::test::random_hash () }, 1024 * 1024);
+		vote_cache.vote (vote->hashes.front (), vote);
+		low.push_back (vote->hashes.front ());
+	}
+	std::vector<nano::block_hash> high;
+	for (int n = 0; n < 5; ++n)
+	{
+		auto vote = nano::test::make_vote (rep2, { nano::test::random_hash () }, 1024 * 1024);
+		vote_cache.vote (vote->hashes.front (), vote);
+		high.push_back (vote->hashes.front ());
+	}
+	ASSERT_EQ (5, vote_cache.top (2).size ());
+
+	// An untracked entry receiving a vote becomes the highest one
+	auto vote = nano::test::make_vote (rep2, { low.front () }, 1024 * 1024);
+	vote_cache.vote (vote->hashes.front (), vote);
+	auto tops1 = vote_cache.top (2);
+	ASSERT_EQ (6, tops1.size ());
+	ASSERT_EQ (low.front (), tops1[0].hash);
+	ASSERT_EQ (6, tops1[0].tally);
+
+	// Removing the tracked entries makes the remaining ones visible again
+	vote_cache.erase (low.front ());
+	for (auto const & hash : high)
+	{
+		vote_cache.erase (hash);
+	}
+	ASSERT_TRUE (vote_cache.top (2).empty ());
+	auto tops2 = vote_cache.top (1);
+	ASSERT_FALSE (tops2.empty ());
+	ASSERT_EQ (1, tops2[0].tally);
+}
@@ -95,6 +95,37 @@ TEST (vote_processor, no_capacity)
 	ASSERT_TRUE (node.vote_processor.vote (vote, channel));
 }
 
+TEST (vote_processor, duplicate)
+{
+	nano::test::system system{ 2 };
+	auto & node = *system.nodes[0];
+	auto & node2 = *system.nodes[1];
+	auto chain = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	nano::keypair key;
+	auto vote = nano::test::make_vote (key, { chain[0] }, nano::vote::timestamp_min * 1, 0);
+	auto channel1 = std::make_shared<nano::transport::inproc::channel> (node, node);
+	auto channel2 = std::make_shared<nano::transport::inproc::channel> (node, node2);
+	auto election = nano::test::start_election (system, node, chain[0]->hash ());
+	ASSERT_NE (nullptr, election);
+	ASSERT_FALSE (node.vote_processor.vote (vote, channel1));
+	ASSERT_TIMELY_EQ (5s, 2, election->votes ().size ());
+	ASSERT_FALSE (node.vote_processor.vote (vote, channel1));
+	node.vote_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_duplicate));
+	// The same vote relayed by a different peer is still processed
+	ASSERT_FALSE (node.vote_processor.vote (vote, channel2));
+	node.vote_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_duplicate));
+	// Votes not applied to an election are released from the filter so a rebroadcast is processed again
+	nano::keypair key2;
+	auto vote_unknown = nano::test::make_vote (key2, { nano::dev::genesis }, nano::vote::timestamp_min * 1, 0);
+	ASSERT_FALSE (node.vote_processor.vote (vote_unknown, channel1));
+	node.vote_processor.flush ();
+	ASSERT_FALSE (node.vote_processor.vote (vote_unknown, channel1));
+	node.vote_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_duplicate));
+}
+
 TEST (vote_processor, overflow)
 {
 	nano::test::system system;
@@ -124,6 +155,25 @@ TEST (vote_processor, overflow)
 	ASSERT_LT (std::chrono::system_clock::now () - start_time, 10s);
 }
 
+TEST (vote_processor, shards)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	config.vote_processor_threads = 4;
+	auto & node (*system.add_node (config));
+	auto channel (std::make_shared<nano::transport::inproc::channel> (node, node));
+	std::size_t const count = 64;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		nano::keypair key;
+		ASSERT_FALSE (node.vote_processor.vote (nano::test::make_vote (key, { nano::dev::genesis }, nano::vote::timestamp_min * 1, 0), channel));
+	}
+	// Votes from different representatives are spread over shards, every vote is processed exactly once
+	ASSERT_TIMELY_EQ (5s, node.vote_processor.total_processed, count);
+	ASSERT_EQ (count, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_indeterminate));
+	ASSERT_TRUE (node.vote_processor.empty ());
+}
+
 namespace nano
 {
 TEST (vote_processor, weights)
@@ -154,24 +204,27 @@ TEST (vote_processor, weights)
 	system.wallet (0)->send_sync (nano::dev::genesis_key.pub, key2.pub, level2);
 
 	// Wait for representatives
-	ASSERT_TIMELY_EQ (10s, node.ledger.cache.rep_weights.get_rep_amounts ().size (), 4);
+	ASSERT_TIMELY_EQ (10s, node.ledger.cache.rep_weights.get_rep_amounts ()->size (), 4);
 	node.vote_processor.calculate_weights ();
 
-	ASSERT_EQ (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key0.pub));
-	ASSERT_EQ (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key0.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key0.pub));
+	// Representative levels are kept by the shard each representative is assigned to
+	auto shard = [&node] (nano::account const & representative) -> auto & { return node.vote_processor.shard_for (representative); };
+
+	ASSERT_EQ (shard (key0.pub).representatives_1.end (), shard (key0.pub).representatives_1.find (key0.pub));
+	ASSERT_EQ (shard (key0.pub).representatives_2.end (), shard (key0.pub).representatives_2.find (key0.pub));
+	ASSERT_EQ (shard (key0.pub).representatives_3.end (), shard (key0.pub).representatives_3.find (key0.pub));
 
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key1.pub));
-	ASSERT_EQ (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key1.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key1.pub));
+	ASSERT_NE (shard (key1.pub).representatives_1.end (), shard (key1.pub).representatives_1.find (key1.pub));
+	ASSERT_EQ (shard (key1.pub).representatives_2.end (), shard (key1.pub).representatives_2.find (key1.pub));
+	ASSERT_EQ (shard (key1.pub).representatives_3.end (), shard (key1.pub).representatives_3.find (key1.pub));
 
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (key2.pub));
-	ASSERT_NE (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (key2.pub));
-	ASSERT_EQ (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (key2.pub));
+	ASSERT_NE (shard (key2.pub).representatives_1.end (), shard (key2.pub).representatives_1.find (key2.pub));
+	ASSERT_NE (shard (key2.pub).representatives_2.end (), shard (key2.pub).representatives_2.find (key2.pub));
+	ASSERT_EQ (shard (key2.pub).representatives_3.end (), shard (key2.pub).representatives_3.find (key2.pub));
 
-	ASSERT_NE (node.vote_processor.representatives_1.end (), node.vote_processor.representatives_1.find (nano::dev::genesis_key.pub));
-	ASSERT_NE (node.vote_processor.representatives_2.end (), node.vote_processor.representatives_2.find (nano::dev::genesis_key.pub));
-	ASSERT_NE (node.vote_processor.representatives_3.end (), node.vote_processor.representatives_3.find (nano::dev::genesis_key.pub));
+	ASSERT_NE (shard (nano::dev::genesis_key.pub).representatives_1.end (), shard (nano::dev::genesis_key.pub).representatives_1.find (nano::dev::genesis_key.pub));
+	ASSERT_NE (shard (nano::dev::genesis_key.pub).representatives_2.end (), shard (nano::dev::genesis_key.pub).representatives_2.find (nano::dev::genesis_key.pub));
+	ASSERT_NE (shard (nano::dev::genesis_key.pub).representatives_3.end (), shard (nano::dev::genesis_key.pub).representatives_3.find (nano::dev::genesis_key.pub));
 }
 }
 
@@ -102,6 +102,8 @@ TEST (vote_generator, multiple_representatives)
 			return vote_a->account == account;
 		}));
 		ASSERT_NE (votes.end (), existing);
+		// Votes are signed concurrently, each one must carry its own representative's signature
+		ASSERT_FALSE ((*existing)->validate ());
 	}
 }
 
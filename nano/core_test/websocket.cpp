@@ -690,6 +690,38 @@ TEST (websocket, vote_options_type)
 	ASSERT_EQ ("replay", message_contents.get<std::string> ("type"));
 }
 
+// Tests that a message is serialized once and filtered on the fields extracted by the builder
+TEST (websocket, message_serialized_once)
+{
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, { nano::dev::genesis }, 0, 0);
+	nano::websocket::message_builder builder;
+	auto msg (builder.vote_received (vote, nano::vote_code::replay));
+	ASSERT_EQ ("replay", msg.filter.type);
+	ASSERT_EQ (nano::dev::genesis_key.pub, msg.filter.account);
+	ASSERT_FALSE (msg.filter.destination);
+
+	auto const & buffer1 (msg.serialized ());
+	auto const & buffer2 (msg.serialized ());
+	ASSERT_EQ (buffer1.begin ()->data (), buffer2.begin ()->data ());
+	auto bytes (buffer1.to_bytes ());
+	ASSERT_EQ (msg.to_string (), std::string (bytes.begin (), bytes.end ()));
+
+	nano::logger logger;
+	boost::property_tree::ptree options;
+	options.put ("include_replays", "true");
+	boost::property_tree::ptree representatives;
+	boost::property_tree::ptree entry;
+	entry.put ("", nano::dev::genesis_key.pub.to_account ());
+	representatives.push_back (std::make_pair ("", entry));
+	options.add_child ("representatives", representatives);
+	nano::websocket::vote_options vote_options (options, logger);
+	ASSERT_FALSE (vote_options.should_filter (msg));
+
+	nano::keypair key;
+	auto other_vote = nano::test::make_vote (key, { nano::dev::genesis }, 0, 0);
+	ASSERT_TRUE (vote_options.should_filter (builder.vote_received (other_vote, nano::vote_code::vote)));
+}
+
 // Tests vote subscription options - list of representatives
 TEST (websocket, vote_options_representatives)
 {
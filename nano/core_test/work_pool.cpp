@@ -3,6 +3,7 @@
 #include <nano/lib/logging.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_hash.hpp>
 #include <nano/node/openclconfig.hpp>
 #include <nano/node/openclwork.hpp>
 #include <nano/secure/common.hpp>
@@ -189,3 +190,92 @@ TEST (work, eco_pow)
 	// It's possible under some unlucky circumstances that this fails to the random nature of valid work generation.
 	ASSERT_LT (future1.get (), future2.get ());
 }
+
+TEST (work, hash_matches_blake2b)
+{
+	// Not a multiple of any lane count, so partially filled batches are covered too
+	std::size_t const count = 3 * nano::work_hash::max_lanes + 3;
+	std::vector<nano::root> roots (count);
+	std::vector<uint64_t> works (count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		nano::random_pool::generate_block (roots[i].bytes.data (), roots[i].bytes.size ());
+		nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (&works[i]), sizeof (works[i]));
+	}
+	auto reference = [] (nano::root const & root, uint64_t work) {
+		uint64_t result;
+		blake2b_state hash;
+		blake2b_init (&hash, sizeof (result));
+		blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
+		blake2b_update (&hash, root.bytes.data (), root.bytes.size ());
+		blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), sizeof (result));
+		return result;
+	};
+	std::vector<uint64_t> values (count);
+	nano::work_hash::values (roots.data (), works.data (), values.data (), count);
+	std::vector<uint64_t> same_root_values (count);
+	nano::work_hash::values (roots[0], works.data (), same_root_values.data (), count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		ASSERT_EQ (reference (roots[i], works[i]), values[i]);
+		ASSERT_EQ (reference (roots[i], works[i]), nano::work_hash::value (roots[i], works[i]));
+		ASSERT_EQ (reference (roots[0], works[i]), same_root_values[i]);
+	}
+	// Every implementation this CPU supports, not only the selected one
+	auto const implementations = nano::work_hash::implementations ();
+	ASSERT_FALSE (implementations.empty ());
+	ASSERT_EQ (nano::work_hash::implementation (), implementations.front ());
+	ASSERT_EQ ("scalar", implementations.back ());
+	for (auto const & implementation : implementations)
+	{
+		std::vector<uint64_t> implementation_values (count);
+		nano::work_hash::values (implementation, roots.data (), works.data (), implementation_values.data (), count);
+		std::vector<uint64_t> implementation_same_root_values (count);
+		nano::work_hash::values (implementation, roots[0], works.data (), implementation_same_root_values.data (), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ (reference (roots[i], works[i]), implementation_values[i]) << implementation;
+			ASSERT_EQ (reference (roots[0], works[i]), implementation_same_root_values[i]) << implementation;
+		}
+	}
+}
+
+TEST (work, validate_entries)
+{
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	for (auto i = 0; i < 10; ++i)
+	{
+		auto block = builder
+					 .send ()
+					 .previous (i + 1)
+					 .destination (1)
+					 .balance (2)
+					 .sign (nano::keypair ().prv, 4)
+					 .work (6)
+					 .build_shared ();
+		// Every other block gets valid work
+		if (i % 2 == 0)
+		{
+			block->block_work_set (*pool.generate (block->root ()));
+		}
+		else
+		{
+			while (!nano::dev::network_params.work.validate_entry (*block))
+			{
+				block->block_work_set (block->block_work () + 1);
+			}
+		}
+		blocks.push_back (block);
+	}
+	std::vector<nano::block const *> pointers;
+	std::transform (blocks.begin (), blocks.end (), std::back_inserter (pointers), [] (auto const & block) { return block.get (); });
+	auto result = nano::dev::network_params.work.validate_entries (pointers);
+	ASSERT_EQ (blocks.size (), result.size ());
+	for (std::size_t i = 0; i < blocks.size (); ++i)
+	{
+		ASSERT_EQ (nano::dev::network_params.work.validate_entry (*blocks[i]), result[i]);
+		ASSERT_EQ (i % 2 != 0, result[i]);
+	}
+}
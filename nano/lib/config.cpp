@@ -1,6 +1,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/config.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/work_hash.hpp>
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -74,19 +75,23 @@ uint64_t nano::work_thresholds::threshold_entry (nano::work_version const versio
 #ifndef NANO_FUZZER_TEST
 uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_a) const
 {
-	uint64_t result;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (result));
-	blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work_a), sizeof (work_a));
-	blake2b_update (&hash, root_a.bytes.data (), root_a.bytes.size ());
-	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), sizeof (result));
-	return result;
+	return nano::work_hash::value (root_a, work_a);
+}
+
+void nano::work_thresholds::values (nano::root const * roots_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a) const
+{
+	nano::work_hash::values (roots_a, work_a, result_a, count_a);
 }
 #else
 uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_a) const
 {
 	return base + 1;
 }
+
+void nano::work_thresholds::values (nano::root const * roots_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a) const
+{
+	std::fill (result_a, result_a + count_a, base + 1);
+}
 #endif
 
 uint64_t nano::work_thresholds::threshold (nano::block_details const & details_a) const
@@ -209,6 +214,28 @@ bool nano::work_thresholds::validate_entry (nano::block const & block_a) const
 	return difficulty (block_a) < threshold_entry (block_a.work_version (), block_a.type ());
 }
 
+std::vector<bool> nano::work_thresholds::validate_entries (std::vector<nano::block const *> const & blocks_a) const
+{
+	std::vector<nano::root> roots;
+	std::vector<uint64_t> works;
+	roots.reserve (blocks_a.size ());
+	works.reserve (blocks_a.size ());
+	for (auto const block : blocks_a)
+	{
+		debug_assert (block->work_version () == nano::work_version::work_1);
+		roots.push_back (block->root ());
+		works.push_back (block->block_work ());
+	}
+	std::vector<uint64_t> difficulties (blocks_a.size ());
+	values (roots.data (), works.data (), difficulties.data (), blocks_a.size ());
+	std::vector<bool> result (blocks_a.size ());
+	for (std::size_t i = 0; i < blocks_a.size (); ++i)
+	{
+		result[i] = difficulties[i] < threshold_entry (blocks_a[i]->work_version (), blocks_a[i]->type ());
+	}
+	return result;
+}
+
 namespace nano
 {
 char const * network_constants::active_network_err_msg = "Invalid network. Valid values are live, test, beta and dev.";
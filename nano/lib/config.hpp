@@ -11,6 +11,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -172,12 +173,16 @@ public:
 	uint64_t threshold (nano::work_version const, nano::block_details const) const;
 	uint64_t threshold_base (nano::work_version const) const;
 	uint64_t value (nano::root const & root_a, uint64_t work_a) const;
+	/** Computes `value` for \p count_a root and work pairs at once */
+	void values (nano::root const * roots_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a) const;
 	double normalized_multiplier (double const, uint64_t const) const;
 	double denormalized_multiplier (double const, uint64_t const) const;
 	uint64_t difficulty (nano::work_version const, nano::root const &, uint64_t const) const;
 	uint64_t difficulty (nano::block const & block_a) const;
 	bool validate_entry (nano::work_version const, nano::root const &, uint64_t const) const;
 	bool validate_entry (nano::block const &) const;
+	/** Validates the work of all blocks at once, an element is true when `validate_entry` would return true for the corresponding block */
+	std::vector<bool> validate_entries (std::vector<nano::block const *> const &) const;
 
 	/** Network work thresholds. Define these inline as constexpr when moving to cpp17. */
 	static nano::work_thresholds const publish_full;
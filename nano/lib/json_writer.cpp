@@ -0,0 +1,158 @@
+#include <nano/lib/json_writer.hpp>
+#include <nano/lib/utility.hpp>
+
+void nano::json_writer::begin_object ()
+{
+	element ();
+	begin (false);
+}
+
+void nano::json_writer::begin_object (std::string_view key)
+{
+	field (key);
+	begin (false);
+}
+
+void nano::json_writer::end_object ()
+{
+	end (false);
+}
+
+void nano::json_writer::begin_array ()
+{
+	element ();
+	begin (true);
+}
+
+void nano::json_writer::begin_array (std::string_view key)
+{
+	field (key);
+	begin (true);
+}
+
+void nano::json_writer::end_array ()
+{
+	end (true);
+}
+
+void nano::json_writer::put (std::string_view key, std::string_view value)
+{
+	field (key);
+	string (value);
+}
+
+void nano::json_writer::put (std::string_view value)
+{
+	element ();
+	string (value);
+}
+
+std::size_t nano::json_writer::count () const
+{
+	debug_assert (!scopes.empty ());
+	return scopes.back ().count;
+}
+
+std::size_t nano::json_writer::size () const
+{
+	return buffer.size ();
+}
+
+std::string nano::json_writer::release ()
+{
+	debug_assert (scopes.empty ());
+	return std::move (buffer);
+}
+
+void nano::json_writer::element ()
+{
+	if (!scopes.empty ())
+	{
+		auto & current = scopes.back ();
+		debug_assert (current.array);
+		if (current.count++ > 0)
+		{
+			buffer.push_back (',');
+		}
+	}
+}
+
+void nano::json_writer::field (std::string_view key)
+{
+	debug_assert (!scopes.empty () && !scopes.back ().array);
+	auto & current = scopes.back ();
+	if (current.count++ > 0)
+	{
+		buffer.push_back (',');
+	}
+	string (key);
+	buffer.push_back (':');
+}
+
+void nano::json_writer::begin (bool array)
+{
+	buffer.push_back (array ? '[' : '{');
+	scopes.push_back ({ array });
+}
+
+void nano::json_writer::end (bool array)
+{
+	debug_assert (!scopes.empty () && scopes.back ().array == array);
+	if (scopes.back ().count == 0)
+	{
+		// Empty containers have no children in a property tree and are written as an empty value
+		buffer.pop_back ();
+		buffer.append ("\"\"");
+	}
+	else
+	{
+		buffer.push_back (array ? ']' : '}');
+	}
+	scopes.pop_back ();
+}
+
+void nano::json_writer::string (std::string_view value)
+{
+	static char const hex[] = "0123456789abcdef";
+	buffer.push_back ('"');
+	for (auto c : value)
+	{
+		switch (c)
+		{
+			case '"':
+				buffer.append ("\\\"");
+				break;
+			case '\\':
+				buffer.append ("\\\\");
+				break;
+			case '\b':
+				buffer.append ("\\b");
+				break;
+			case '\f':
+				buffer.append ("\\f");
+				break;
+			case '\n':
+				buffer.append ("\\n");
+				break;
+			case '\r':
+				buffer.append ("\\r");
+				break;
+			case '\t':
+				buffer.append ("\\t");
+				break;
+			default:
+				if (static_cast<unsigned char> (c) < 0x20)
+				{
+					buffer.append ("\\u00");
+					buffer.push_back (hex[(c >> 4) & 0xf]);
+					buffer.push_back (hex[c & 0xf]);
+				}
+				else
+				{
+					buffer.push_back (c);
+				}
+				break;
+		}
+	}
+	buffer.push_back ('"');
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Streaming JSON emitter writing text directly, for responses too large to build as a property tree.
+ * Output follows boost::property_tree::write_json conventions so clients see the same documents:
+ * every value is a string and empty objects or arrays are written as "".
+ */
+class json_writer final
+{
+public:
+	/** Object at the top level or as an array element */
+	void begin_object ();
+	void begin_object (std::string_view key);
+	void end_object ();
+	/** Array at the top level or as an array element */
+	void begin_array ();
+	void begin_array (std::string_view key);
+	void end_array ();
+	/** Field of the current object */
+	void put (std::string_view key, std::string_view value);
+	/** Element of the current array */
+	void put (std::string_view value);
+
+	/** Number of fields or elements written to the current object or array */
+	std::size_t count () const;
+	std::size_t size () const;
+	/** Takes the completed document, every object and array must be closed */
+	std::string release ();
+
+private:
+	class scope final
+	{
+	public:
+		bool array;
+		std::size_t count{ 0 };
+	};
+
+	void element ();
+	void field (std::string_view key);
+	void begin (bool array);
+	void end (bool array);
+	void string (std::string_view);
+
+	std::string buffer;
+	std::vector<scope> scopes;
+};
+}
@@ -21,9 +21,12 @@ nano::error nano::lmdb_config::serialize_toml (nano::tomlconfig & toml) const
 		case nano::lmdb_config::sync_strategy::nosync_unsafe_large_memory:
 			sync_string = "nosync_unsafe_large_memory";
 			break;
+		case nano::lmdb_config::sync_strategy::group_commit:
+			sync_string = "group_commit";
+			break;
 	}
 
-	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
+	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory, group_commit}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
 	return toml.get_error ();
@@ -55,6 +58,10 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			sync = nano::lmdb_config::sync_strategy::nosync_unsafe_large_memory;
 		}
+		else if (sync_string == "group_commit")
+		{
+			sync = nano::lmdb_config::sync_strategy::group_commit;
+		}
 		else
 		{
 			toml.get_error ().set (sync_string + " is not a valid sync option");
@@ -36,7 +36,13 @@ public:
 		 * may be slower.
 		 * @warning Do not use this option if external processes uses the database concurrently.
 		 */
-		nosync_unsafe_large_memory
+		nosync_unsafe_large_memory,
+		/**
+		 * Group commit. Consecutive writers of the node write queue commit without flushing and the group is flushed once
+		 * when the queue runs empty or a maximum group size is reached. Only the latest group may be lost on system crash,
+		 * integrity guarantees are the same as nosync_unsafe. Commits made outside of the write queue are synced individually.
+		 */
+		group_commit
 	};
 
 	nano::error serialize_toml (nano::tomlconfig & toml_a) const;
@@ -1,6 +1,48 @@
 #include <nano/lib/rep_weights.hpp>
 #include <nano/store/component.hpp>
 
+nano::uint128_t nano::rep_weights::entry::load () const
+{
+	uint64_t sequence_1;
+	uint64_t sequence_2;
+	uint64_t high_l;
+	uint64_t low_l;
+	do
+	{
+		sequence_1 = sequence.load (std::memory_order_acquire);
+		high_l = high.load (std::memory_order_relaxed);
+		low_l = low.load (std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_acquire);
+		sequence_2 = sequence.load (std::memory_order_relaxed);
+	} while ((sequence_1 & 1) != 0 || sequence_1 != sequence_2);
+	return (nano::uint128_t{ high_l } << 64) | low_l;
+}
+
+void nano::rep_weights::entry::store (nano::uint128_t const & value)
+{
+	auto const sequence_l = sequence.load (std::memory_order_relaxed);
+	sequence.store (sequence_l + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+	high.store (static_cast<uint64_t> (value >> 64), std::memory_order_relaxed);
+	low.store (static_cast<uint64_t> (value), std::memory_order_relaxed);
+	sequence.store (sequence_l + 2, std::memory_order_release);
+}
+
+std::shared_ptr<nano::rep_weights::index_t const> nano::rep_weights::stripe::load () const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return index;
+}
+
+void nano::rep_weights::stripe::store (std::shared_ptr<index_t const> index_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	index.swap (index_a);
+	// Previous index is released after the lock, outside of the critical section
+}
+
+nano::rep_weights::rep_weights () = default;
+
 void nano::rep_weights::representation_add (nano::account const & source_rep_a, nano::uint128_t const & amount_a)
 {
 	nano::lock_guard<nano::mutex> guard (mutex);
@@ -32,48 +74,90 @@ void nano::rep_weights::representation_put (nano::account const & account_a, nan
 
 nano::uint128_t nano::rep_weights::representation_get (nano::account const & account_a) const
 {
-	nano::lock_guard<nano::mutex> lk (mutex);
 	return get (account_a);
 }
 
-/** Makes a copy */
-std::unordered_map<nano::account, nano::uint128_t> nano::rep_weights::get_rep_amounts () const
+std::shared_ptr<nano::rep_weights::rep_amounts_t const> nano::rep_weights::get_rep_amounts () const
 {
-	nano::lock_guard<nano::mutex> guard (mutex);
-	return rep_amounts;
+	nano::lock_guard<nano::mutex> guard (snapshot_mutex);
+	auto const version_l = version.load ();
+	if (snapshot == nullptr || snapshot_version != version_l)
+	{
+		auto result = std::make_shared<rep_amounts_t> ();
+		for (auto const & stripe : stripes)
+		{
+			auto index = stripe.load ();
+			for (auto const & [account, entry] : *index)
+			{
+				result->emplace (account, entry->load ());
+			}
+		}
+		snapshot = std::move (result);
+		snapshot_version = version_l;
+	}
+	return snapshot;
+}
+
+uint64_t nano::rep_weights::generation () const
+{
+	return version.load ();
 }
 
 void nano::rep_weights::copy_from (nano::rep_weights & other_a)
 {
+	auto other_amounts = other_a.get_rep_amounts ();
 	nano::lock_guard<nano::mutex> guard_this (mutex);
-	nano::lock_guard<nano::mutex> guard_other (other_a.mutex);
-	for (auto const & entry : other_a.rep_amounts)
+	for (auto const & entry : *other_amounts)
 	{
 		auto prev_amount (get (entry.first));
 		put (entry.first, prev_amount + entry.second);
 	}
 }
 
+auto nano::rep_weights::stripe_for (nano::account const & account_a) -> stripe &
+{
+	return stripes[account_a.bytes[0] % stripe_count];
+}
+
+auto nano::rep_weights::stripe_for (nano::account const & account_a) const -> stripe const &
+{
+	return stripes[account_a.bytes[0] % stripe_count];
+}
+
+auto nano::rep_weights::find (nano::account const & account_a) const -> entry *
+{
+	auto index = stripe_for (account_a).load ();
+	auto it = index->find (account_a);
+	// Entries are never removed and are shared by every republished index, so they outlive this index reference
+	return it != index->end () ? it->second.get () : nullptr;
+}
+
 void nano::rep_weights::put (nano::account const & account_a, nano::uint128_union const & representation_a)
 {
-	auto it = rep_amounts.find (account_a);
+	debug_assert (!mutex.try_lock ());
 	auto amount = representation_a.number ();
-	if (it != rep_amounts.end ())
+	if (auto existing = find (account_a))
 	{
-		it->second = amount;
+		existing->store (amount);
 	}
 	else
 	{
-		rep_amounts.emplace (account_a, amount);
+		// New representative, publish a copy of the stripe index including it
+		auto & stripe = stripe_for (account_a);
+		auto index = std::make_shared<index_t> (*stripe.load ());
+		auto new_entry = std::make_shared<entry> ();
+		new_entry->store (amount);
+		index->emplace (account_a, std::move (new_entry));
+		stripe.store (std::move (index));
 	}
+	++version;
 }
 
 nano::uint128_t nano::rep_weights::get (nano::account const & account_a) const
 {
-	auto it = rep_amounts.find (account_a);
-	if (it != rep_amounts.end ())
+	if (auto existing = find (account_a))
 	{
-		return it->second;
+		return existing->load ();
 	}
 	else
 	{
@@ -83,13 +167,12 @@ nano::uint128_t nano::rep_weights::get (nano::account const & account_a) const
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::rep_weights const & rep_weights, std::string const & name)
 {
-	size_t rep_amounts_count;
-
+	size_t rep_amounts_count = 0;
+	for (auto const & stripe : rep_weights.stripes)
 	{
-		nano::lock_guard<nano::mutex> guard (rep_weights.mutex);
-		rep_amounts_count = rep_weights.rep_amounts.size ();
+		rep_amounts_count += stripe.load ()->size ();
 	}
-	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
+	auto sizeof_element = sizeof (nano::rep_weights::index_t::value_type) + sizeof (nano::rep_weights::entry);
 	auto composite = std::make_unique<nano::container_info_composite> (name);
 	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
 	return composite;
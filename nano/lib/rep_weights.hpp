@@ -3,6 +3,8 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -14,19 +16,69 @@ namespace store
 	class component;
 }
 
+/**
+ * Representative weights, read on every vote tally so the read path never takes a lock.
+ * Each weight lives in its own entry updated in place by writers and read with a sequence lock.
+ * Entries are found through striped immutable indexes, a stripe index is only copied and republished when a new representative appears.
+ * Each stripe guards its index pointer with its own mutex, held only long enough to copy or swap the pointer.
+ */
 class rep_weights
 {
 public:
+	using rep_amounts_t = std::unordered_map<nano::account, nano::uint128_t>;
+
+	rep_weights ();
 	void representation_add (nano::account const & source_rep_a, nano::uint128_t const & amount_a);
 	void representation_add_dual (nano::account const & source_rep_1, nano::uint128_t const & amount_1, nano::account const & source_rep_2, nano::uint128_t const & amount_2);
 	nano::uint128_t representation_get (nano::account const & account_a) const;
 	void representation_put (nano::account const & account_a, nano::uint128_union const & representation_a);
-	std::unordered_map<nano::account, nano::uint128_t> get_rep_amounts () const;
+	/** Immutable snapshot of all weights, shared between callers until a weight changes */
+	std::shared_ptr<rep_amounts_t const> get_rep_amounts () const;
+	/** Changes whenever any weight changes, read before weights to detect changes made after reading them */
+	uint64_t generation () const;
 	void copy_from (rep_weights & other_a);
 
 private:
+	class entry final
+	{
+	public:
+		nano::uint128_t load () const;
+		/** Writers must be serialized */
+		void store (nano::uint128_t const &);
+
+	private:
+		std::atomic<uint64_t> sequence{ 0 };
+		std::atomic<uint64_t> high{ 0 };
+		std::atomic<uint64_t> low{ 0 };
+	};
+
+	using index_t = std::unordered_map<nano::account, std::shared_ptr<entry>>;
+
+	class stripe final
+	{
+	public:
+		std::shared_ptr<index_t const> load () const;
+		void store (std::shared_ptr<index_t const>);
+
+	private:
+		mutable nano::mutex mutex;
+		std::shared_ptr<index_t const> index{ std::make_shared<index_t const> () };
+	};
+
+	static std::size_t constexpr stripe_count = 256;
+	std::array<stripe, stripe_count> stripes;
+
+	/** Serializes writers */
 	mutable nano::mutex mutex;
-	std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
+	/** Incremented on every write, used to tell whether the cached snapshot is still current */
+	std::atomic<uint64_t> version{ 0 };
+	mutable nano::mutex snapshot_mutex;
+	mutable std::shared_ptr<rep_amounts_t const> snapshot;
+	mutable uint64_t snapshot_version{ 0 };
+
+	stripe & stripe_for (nano::account const &);
+	stripe const & stripe_for (nano::account const &) const;
+	entry * find (nano::account const &) const;
 	void put (nano::account const & account_a, nano::uint128_union const & representation_a);
 	nano::uint128_t get (nano::account const & account_a) const;
 
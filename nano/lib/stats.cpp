@@ -1,11 +1,13 @@
 #include <nano/lib/jsonconfig.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/stats.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/lib/tomlconfig.hpp>
 
 #include <boost/format.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <sstream>
@@ -313,16 +315,25 @@ void nano::stats::log_counters_impl (stat_log_sink & sink)
 		sink.write_header ("counters", walltime);
 	}
 
-	for (auto & it : entries)
+	auto const now = std::chrono::system_clock::now ();
+	for (std::size_t index = 0; index < counter_count; ++index)
 	{
-		std::time_t time = std::chrono::system_clock::to_time_t (it.second->counter.get_timestamp ());
+		auto const key = key_at (index);
+		auto const value = count_impl (index);
+		auto existing = entries.find (key);
+		if (value == 0 && existing == entries.end ())
+		{
+			continue;
+		}
+		auto const entry = existing != entries.end () ? existing->second : nullptr;
+
+		std::time_t time = std::chrono::system_clock::to_time_t (entry ? entry->counter_timestamp : now);
 		tm local_tm = *localtime (&time);
 
-		auto key = it.first;
 		std::string type = type_to_string (key);
 		std::string detail = detail_to_string (key);
 		std::string dir = dir_to_string (key);
-		sink.write_entry (local_tm, type, detail, dir, it.second->counter.get_value (), it.second->histogram.get ());
+		sink.write_entry (local_tm, type, detail, dir, value, entry ? entry->histogram.get () : nullptr);
 	}
 	sink.entries ()++;
 	sink.finalize ();
@@ -386,7 +397,67 @@ nano::stat_histogram * nano::stats::get_histogram (stat::type type, stat::detail
 	return entry->histogram.get ();
 }
 
+void nano::stats::observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void (uint64_t, uint64_t)> observer)
+{
+	auto const key = key_of (type, detail, dir);
+	get_entry (key)->count_observers.add (observer);
+	counters->observed[index_of (key)] = true;
+}
+
+std::size_t nano::stats::index_of (uint32_t key)
+{
+	auto const type = key >> 16 & 0xff;
+	auto const detail = key >> 8 & 0xff;
+	auto const dir = key & 0xff;
+	debug_assert (type < type_count && detail < detail_count && dir < dir_count);
+	return (type * detail_count + detail) * dir_count + dir;
+}
+
+uint32_t nano::stats::key_at (std::size_t index)
+{
+	auto const dir = index % dir_count;
+	auto const detail = index / dir_count % detail_count;
+	auto const type = index / dir_count / detail_count;
+	return static_cast<uint32_t> (type << 16 | detail << 8 | dir);
+}
+
+std::size_t nano::stats::shard_index () const
+{
+	static std::atomic<std::size_t> next_thread{ 0 };
+	thread_local std::size_t const thread = next_thread.fetch_add (1, std::memory_order_relaxed);
+	return thread % counters->shards.size ();
+}
+
+nano::stats::counter_storage::counter_storage () :
+	shards (std::clamp<std::size_t> (nano::hardware_concurrency () / 4, 1, max_shard_count))
+{
+}
+
+uint64_t nano::stats::count_impl (std::size_t index) const
+{
+	uint64_t result = 0;
+	for (auto const & shard : counters->shards)
+	{
+		result += shard.values[index].load (std::memory_order_relaxed);
+	}
+	return result;
+}
+
 void nano::stats::update (uint32_t key_a, uint64_t value)
+{
+	if (stopped.load (std::memory_order_relaxed))
+	{
+		return;
+	}
+	auto const index = index_of (key_a);
+	counters->shards[shard_index ()].values[index].fetch_add (value, std::memory_order_relaxed);
+	if (config.sampling_enabled || config.log_interval_counters > 0 || counters->observed[index].load (std::memory_order_relaxed))
+	{
+		update_locked (key_a, value);
+	}
+}
+
+void nano::stats::update_locked (uint32_t key_a, uint64_t value)
 {
 	static file_writer log_count (config.log_counters_filename);
 	static file_writer log_sample (config.log_samples_filename);
@@ -403,9 +474,16 @@ void nano::stats::update (uint32_t key_a, uint64_t value)
 		};
 
 		// Counters
-		auto old (entry->counter.get_value ());
-		entry->counter.add (value, has_sampling ()); // Only update timestamp when sampling is enabled as this has a performance impact
-		entry->count_observers.notify (old, entry->counter.get_value ());
+		if (!entry->count_observers.empty ())
+		{
+			// Concurrent unlocked updates may land in between, observers see the value including this update
+			auto const current = count_impl (index_of (key_a));
+			entry->count_observers.notify (current - value, current);
+		}
+		if (has_sampling ())
+		{
+			entry->counter_timestamp = std::chrono::system_clock::now (); // Only update timestamp when sampling is enabled as this has a performance impact
+		}
 		if (has_interval_counter () || has_sampling ())
 		{
 			auto now = std::chrono::steady_clock::now (); // Only sample clock if necessary as this impacts node performance due to frequent usage
@@ -488,6 +566,18 @@ std::string nano::stats::to_string (std::string type)
 void nano::stats::clear ()
 {
 	nano::unique_lock<nano::mutex> lock{ stat_mutex };
+	for (auto & shard : counters->shards)
+	{
+		for (auto & value : shard.values)
+		{
+			value.store (0, std::memory_order_relaxed);
+		}
+	}
+	// Observers are dropped together with the entries
+	for (auto & observed : counters->observed)
+	{
+		observed.store (false, std::memory_order_relaxed);
+	}
 	entries.clear ();
 	timestamp = std::chrono::steady_clock::now ();
 }
@@ -7,12 +7,15 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <initializer_list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace nano
 {
@@ -116,7 +119,8 @@ private:
 };
 
 /**
- * Bookkeeping of statistics for a specific type/detail/direction combination
+ * Bookkeeping of samples, histograms and observers for a specific type/detail/direction combination.
+ * Counter values are not stored here, see `nano::stats`.
  */
 class stat_entry final
 {
@@ -138,8 +142,8 @@ public:
 	/** Value within the current sample interval */
 	stat_datapoint sample_current;
 
-	/** Counting value for this entry, including the time of last update. This is never reset and only increases. */
-	stat_datapoint counter;
+	/** Wall time of the last counter update, only maintained while sampling is enabled */
+	std::chrono::system_clock::time_point counter_timestamp{ std::chrono::system_clock::now () };
 
 	/** Optional histogram for this entry */
 	std::unique_ptr<stat_histogram> histogram;
@@ -215,6 +219,11 @@ protected:
  * Collects counts and samples for inbound and outbound traffic, blocks, errors, and so on.
  * Stats can be queried and observed on a type level (such as message and ledger) as well as a more
  * specific detail level (such as send blocks)
+ *
+ * Counters live in dense arrays indexed by type/detail/direction, one array per shard with threads spread over the shards
+ * (a quarter of the CPU threads, at most `max_shard_count`),
+ * so incrementing a counter is a single relaxed atomic add. Shards are only summed up when counters are read.
+ * Sampling, interval logging and count observers still go through the locked entry bookkeeping.
  */
 class stats final
 {
@@ -356,10 +365,7 @@ public:
 	 * To avoid recursion, the observer callback must only use the received counts, not query the stat object.
 	 * @param observer The observer receives the old and the new count.
 	 */
-	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void (uint64_t, uint64_t)> observer)
-	{
-		get_entry (key_of (type, detail, dir))->count_observers.add (observer);
-	}
+	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void (uint64_t, uint64_t)> observer);
 
 	/** Returns a potentially empty list of the last N samples, where N is determined by the 'capacity' configuration */
 	boost::circular_buffer<stat_datapoint> * samples (stat::type type, stat::detail detail, stat::dir dir)
@@ -376,7 +382,7 @@ public:
 	/** Returns current value for the given counter at the detail level */
 	uint64_t count (stat::type type, stat::detail detail, stat::dir dir = stat::dir::in)
 	{
-		return get_entry (key_of (type, detail, dir))->counter.get_value ();
+		return count_impl (index_of (key_of (type, detail, dir)));
 	}
 
 	/** Returns the number of seconds since clear() was last called, or node startup if it's never called. */
@@ -427,6 +433,42 @@ private:
 	 */
 	void update (uint32_t key, uint64_t value);
 
+	/** Sampling, interval logging and count observers for a key whose counter was just incremented by \p value */
+	void update_locked (uint32_t key, uint64_t value);
+
+	static std::size_t constexpr type_count = static_cast<std::size_t> (stat::type::_last);
+	static std::size_t constexpr detail_count = static_cast<std::size_t> (stat::detail::_last);
+	static std::size_t constexpr dir_count = static_cast<std::size_t> (stat::dir::_last);
+	static std::size_t constexpr counter_count = type_count * detail_count * dir_count;
+	/** Every shard holds all counters, so the shard count follows the number of CPU threads up to this limit */
+	static std::size_t constexpr max_shard_count = 8;
+
+	/** Position of the key in the dense counter arrays */
+	static std::size_t index_of (uint32_t key);
+	static uint32_t key_at (std::size_t index);
+	/** Shard used by the calling thread */
+	std::size_t shard_index () const;
+	/** Sum of the counter over all shards */
+	uint64_t count_impl (std::size_t index) const;
+
+	class alignas (64) counter_shard final
+	{
+	public:
+		std::array<std::atomic<uint64_t>, counter_count> values{};
+	};
+
+	class counter_storage final
+	{
+	public:
+		counter_storage ();
+
+		std::vector<counter_shard> shards;
+		/** Keys with count observers, these have to be updated through the locked path */
+		std::array<std::atomic<bool>, counter_count> observed{};
+	};
+
+	std::unique_ptr<counter_storage> counters{ std::make_unique<counter_storage> () };
+
 	/** Unlocked implementation of log_counters() to avoid using recursive locking */
 	void log_counters_impl (stat_log_sink & sink);
 
@@ -445,9 +487,9 @@ private:
 	std::chrono::steady_clock::time_point log_last_sample_writeout{ std::chrono::steady_clock::now () };
 
 	/** Whether stats should be output */
-	bool stopped{ false };
+	std::atomic<bool> stopped{ false };
 
-	/** All access to stat is thread safe, including calls from observers on the same thread */
+	/** Guards the entries and log writeouts. Counters themselves are never locked. */
 	nano::mutex stat_mutex;
 };
 }
@@ -19,6 +19,7 @@ enum class type : uint8_t
 	bootstrap,
 	tcp_server,
 	vote,
+	vote_processor,
 	election,
 	http_callback,
 	ipc,
@@ -31,11 +32,17 @@ enum class type : uint8_t
 	aggregator,
 	requests,
 	filter,
+	vote_filter,
 	telemetry,
 	vote_generator,
 	vote_cache,
 	hinting,
 	blockprocessor,
+	signature_checker,
+	write_queue,
+	write_queue_wait,
+	block_cache,
+	tcp_message_manager,
 	bootstrap_server,
 	active,
 	active_started,
@@ -77,6 +84,9 @@ enum class detail : uint8_t
 	overfill,
 	batch,
 
+	// block processor
+	prevalidated,
+
 	// error specific
 	insufficient_work,
 	http_callback,
@@ -146,6 +156,7 @@ enum class detail : uint8_t
 	vote_indeterminate,
 	vote_invalid,
 	vote_overflow,
+	vote_duplicate,
 
 	// election specific
 	vote_new,
@@ -214,6 +225,15 @@ enum class detail : uint8_t
 	// [request] aggregator
 	aggregator_accepted,
 	aggregator_dropped,
+	aggregator_latency_under_10ms,
+	aggregator_latency_under_25ms,
+	aggregator_latency_under_50ms,
+	aggregator_latency_under_100ms,
+	aggregator_latency_under_200ms,
+	aggregator_latency_under_300ms,
+	aggregator_latency_under_500ms,
+	aggregator_latency_under_1s,
+	aggregator_latency_over_1s,
 
 	// requests
 	requests_cached_hashes,
@@ -226,6 +246,18 @@ enum class detail : uint8_t
 	// duplicate
 	duplicate_publish_message,
 
+	// filter
+	hit,
+	miss,
+	collision,
+
+	// write queue
+	confirmation_height,
+	process_batch,
+	pruning,
+	testing,
+	flush,
+
 	// telemetry
 	invalid_signature,
 	node_id_mismatch,
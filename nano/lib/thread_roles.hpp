@@ -15,6 +15,7 @@ enum class name
 	packet_processing,
 	vote_processing,
 	block_processing,
+	block_prevalidation,
 	request_loop,
 	wallet_actions,
 	bootstrap_initiator,
@@ -24,6 +25,7 @@ enum class name
 	rpc_request_processor,
 	rpc_process_container,
 	confirmation_height_processing,
+	confirmation_height_discovery,
 	worker,
 	bootstrap_worker,
 	request_aggregator,
@@ -4,6 +4,7 @@
 #include <nano/lib/thread_roles.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_hash.hpp>
 #include <nano/node/xorshift.hpp>
 
 #include <future>
@@ -64,8 +65,9 @@ void nano::work_pool::loop (uint64_t thread)
 	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
+	// Nonces are hashed in batches so that every vector lane of the hash implementation is used
+	std::array<uint64_t, nano::work_hash::max_lanes> works;
+	std::array<uint64_t, nano::work_hash::max_lanes> outputs;
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	auto pow_sleep = pow_rate_limiter;
 	while (!done)
@@ -100,14 +102,19 @@ void nano::work_pool::loop (uint64_t thread)
 					// Don't query main memory every iteration in order to reduce memory bus traffic
 					// All operations here operate on stack memory
 					// Count iterations down to zero since comparing to zero is easier than comparing to another number
-					unsigned iteration (256);
+					unsigned iteration (256 / works.size ());
 					while (iteration && output < current_l.difficulty)
 					{
-						work = rng.next ();
-						blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-						blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-						blake2b_init (&hash, sizeof (output));
+						for (auto & work_l : works)
+						{
+							work_l = rng.next ();
+						}
+						nano::work_hash::values (current_l.item, works.data (), outputs.data (), works.size ());
+						for (std::size_t i = 0; i < works.size () && output < current_l.difficulty; ++i)
+						{
+							work = works[i];
+							output = outputs[i];
+						}
 						iteration -= 1;
 					}
 
@@ -0,0 +1,265 @@
+#include <nano/lib/work_hash.hpp>
+
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#define NANO_WORK_HASH_INLINE __forceinline
+#else
+#define NANO_WORK_HASH_INLINE inline __attribute__ ((always_inline))
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NANO_WORK_HASH_X86_DISPATCH
+#endif
+
+namespace
+{
+uint64_t constexpr iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+uint8_t constexpr sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+// Parameter block for an unkeyed 8 byte digest: digest length 8, fanout 1, depth 1
+uint64_t constexpr h0 = iv[0] ^ 0x01010008ULL;
+// Input length, the only block is also the last one
+uint64_t constexpr input_size = sizeof (uint64_t) + sizeof (nano::root);
+
+NANO_WORK_HASH_INLINE uint64_t rotr (uint64_t value, unsigned bits)
+{
+	return (value >> bits) | (value << (64 - bits));
+}
+
+/*
+ * Each lane is an independent hash, every operation is written as a loop over lanes so the compiler maps lanes onto vector registers
+ */
+template <std::size_t L>
+NANO_WORK_HASH_INLINE void g (uint64_t (&v)[16][L], std::size_t a, std::size_t b, std::size_t c, std::size_t d, uint64_t const (&x)[L], uint64_t const (&y)[L])
+{
+	for (std::size_t l = 0; l < L; ++l)
+	{
+		v[a][l] = v[a][l] + v[b][l] + x[l];
+		v[d][l] = rotr (v[d][l] ^ v[a][l], 32);
+		v[c][l] = v[c][l] + v[d][l];
+		v[b][l] = rotr (v[b][l] ^ v[c][l], 24);
+		v[a][l] = v[a][l] + v[b][l] + y[l];
+		v[d][l] = rotr (v[d][l] ^ v[a][l], 16);
+		v[c][l] = v[c][l] + v[d][l];
+		v[b][l] = rotr (v[b][l] ^ v[c][l], 63);
+	}
+}
+
+/** Message words 5 to 15 are always zero as the input is only 40 bytes */
+template <std::size_t L>
+NANO_WORK_HASH_INLINE void compress (uint64_t const (&m)[16][L], uint64_t (&out)[L])
+{
+	uint64_t v[16][L];
+	for (std::size_t l = 0; l < L; ++l)
+	{
+		v[0][l] = h0;
+		for (std::size_t i = 1; i < 8; ++i)
+		{
+			v[i][l] = iv[i];
+		}
+		for (std::size_t i = 0; i < 8; ++i)
+		{
+			v[8 + i][l] = iv[i];
+		}
+		v[12][l] ^= input_size;
+		v[14][l] = ~v[14][l];
+	}
+	for (std::size_t r = 0; r < 12; ++r)
+	{
+		auto const & s = sigma[r];
+		g (v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+		g (v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+		g (v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+		g (v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+		g (v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+		g (v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+		g (v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+		g (v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+	}
+	for (std::size_t l = 0; l < L; ++l)
+	{
+		out[l] = h0 ^ v[0][l] ^ v[8][l];
+	}
+}
+
+/** Root words as read by blake2b, the digest is read back the same way so this matches the byte oriented reference on little endian hosts */
+NANO_WORK_HASH_INLINE void load_root (nano::root const & root, uint64_t (&words)[4])
+{
+	std::memcpy (words, root.bytes.data (), sizeof (words));
+}
+
+/**
+ * Hashes `count` nonces, `root_stride` is 0 when all nonces share the first root and 1 when each nonce has its own
+ */
+template <std::size_t L>
+NANO_WORK_HASH_INLINE void values_impl (nano::root const * roots, std::size_t root_stride, uint64_t const * work, uint64_t * result, std::size_t count)
+{
+	uint64_t m[16][L] = {};
+	uint64_t out[L];
+	uint64_t root_words[4];
+	if (root_stride == 0 && count > 0)
+	{
+		load_root (*roots, root_words);
+		for (std::size_t l = 0; l < L; ++l)
+		{
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				m[1 + i][l] = root_words[i];
+			}
+		}
+	}
+	for (std::size_t offset = 0; offset < count; offset += L)
+	{
+		auto const size = std::min (L, count - offset);
+		// Lanes past the end of the input repeat the last item and are discarded
+		for (std::size_t l = 0; l < L; ++l)
+		{
+			auto const index = offset + std::min (l, size - 1);
+			m[0][l] = work[index];
+			if (root_stride != 0)
+			{
+				load_root (roots[index], root_words);
+				for (std::size_t i = 0; i < 4; ++i)
+				{
+					m[1 + i][l] = root_words[i];
+				}
+			}
+		}
+		compress (m, out);
+		std::copy (out, out + size, result + offset);
+	}
+}
+
+using values_fn = void (*) (nano::root const *, std::size_t, uint64_t const *, uint64_t *, std::size_t);
+
+class implementation_t final
+{
+public:
+	values_fn values;
+	std::size_t lanes;
+	char const * name;
+};
+
+void values_scalar (nano::root const * roots, std::size_t root_stride, uint64_t const * work, uint64_t * result, std::size_t count)
+{
+	values_impl<1> (roots, root_stride, work, result, count);
+}
+
+#ifdef NANO_WORK_HASH_X86_DISPATCH
+__attribute__ ((target ("avx2"))) void values_avx2 (nano::root const * roots, std::size_t root_stride, uint64_t const * work, uint64_t * result, std::size_t count)
+{
+	values_impl<4> (roots, root_stride, work, result, count);
+}
+
+__attribute__ ((target ("avx512f"))) void values_avx512 (nano::root const * roots, std::size_t root_stride, uint64_t const * work, uint64_t * result, std::size_t count)
+{
+	values_impl<8> (roots, root_stride, work, result, count);
+}
+#endif
+
+/** Implementations this CPU can run, fastest first */
+std::vector<implementation_t> supported_impl ()
+{
+	std::vector<implementation_t> result;
+#ifdef NANO_WORK_HASH_X86_DISPATCH
+	__builtin_cpu_init ();
+	if (__builtin_cpu_supports ("avx512f"))
+	{
+		result.push_back ({ values_avx512, 8, "avx512" });
+	}
+	if (__builtin_cpu_supports ("avx2"))
+	{
+		result.push_back ({ values_avx2, 4, "avx2" });
+	}
+#endif
+	result.push_back ({ values_scalar, 1, "scalar" });
+	return result;
+}
+
+std::vector<implementation_t> const & supported ()
+{
+	static std::vector<implementation_t> const result = supported_impl ();
+	return result;
+}
+
+implementation_t const & selected ()
+{
+	return supported ().front ();
+}
+
+implementation_t const & find (std::string_view name)
+{
+	auto const & implementations = supported ();
+	auto existing = std::find_if (implementations.begin (), implementations.end (), [name] (implementation_t const & implementation) { return implementation.name == name; });
+	release_assert (existing != implementations.end (), "work hash implementation not supported on this CPU");
+	return *existing;
+}
+}
+
+uint64_t nano::work_hash::value (nano::root const & root_a, uint64_t work_a)
+{
+	uint64_t result;
+	values_impl<1> (&root_a, 0, &work_a, &result, 1);
+	return result;
+}
+
+void nano::work_hash::values (nano::root const & root_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a)
+{
+	selected ().values (&root_a, 0, work_a, result_a, count_a);
+}
+
+void nano::work_hash::values (nano::root const * roots_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a)
+{
+	selected ().values (roots_a, 1, work_a, result_a, count_a);
+}
+
+std::vector<std::string_view> nano::work_hash::implementations ()
+{
+	std::vector<std::string_view> result;
+	for (auto const & implementation : supported ())
+	{
+		result.push_back (implementation.name);
+	}
+	return result;
+}
+
+void nano::work_hash::values (std::string_view implementation_a, nano::root const & root_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a)
+{
+	find (implementation_a).values (&root_a, 0, work_a, result_a, count_a);
+}
+
+void nano::work_hash::values (std::string_view implementation_a, nano::root const * roots_a, uint64_t const * work_a, uint64_t * result_a, std::size_t count_a)
+{
+	find (implementation_a).values (roots_a, 1, work_a, result_a, count_a);
+}
+
+std::size_t nano::work_hash::lanes ()
+{
+	return selected ().lanes;
+}
+
+char const * nano::work_hash::implementation ()
+{
+	return selected ().name;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace nano::work_hash
+{
+/*
+ * Proof of work hash: blake2b with an 8 byte digest over the 8 byte nonce followed by the 32 byte root, read as a little endian integer.
+ * The 40 byte input always fits in a single blake2b block, so the hash is a single compression with a constant parameter block and no buffering.
+ */
+
+/** Maximum number of hashes computed together by any implementation */
+std::size_t constexpr max_lanes = 8;
+
+uint64_t value (nano::root const &, uint64_t work);
+/** Hashes \p count nonces against the same root */
+void values (nano::root const &, uint64_t const * work, uint64_t * result, std::size_t count);
+/** Hashes \p count independent root and nonce pairs */
+void values (nano::root const * roots, uint64_t const * work, uint64_t * result, std::size_t count);
+
+/** Number of hashes computed together by the implementation selected for this CPU */
+std::size_t lanes ();
+/** Name of the implementation selected for this CPU */
+char const * implementation ();
+
+/** Names of all implementations this CPU supports, the selected one first */
+std::vector<std::string_view> implementations ();
+/** Same as `values`, but using the named implementation, which must be supported by this CPU */
+void values (std::string_view implementation, nano::root const &, uint64_t const * work, uint64_t * result, std::size_t count);
+void values (std::string_view implementation, nano::root const * roots, uint64_t const * work, uint64_t * result, std::size_t count);
+}
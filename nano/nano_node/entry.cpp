@@ -164,7 +164,7 @@ int main (int argc, char * const * argv)
 				auto const bootstrap_weights = node->get_bootstrap_weights ();
 				auto const & hardcoded = bootstrap_weights.second;
 				auto const hardcoded_height = bootstrap_weights.first;
-				auto const ledger_unfiltered = node->ledger.cache.rep_weights.get_rep_amounts ();
+				auto const ledger_unfiltered = *node->ledger.cache.rep_weights.get_rep_amounts ();
 				auto const ledger_height = node->ledger.cache.block_count.load ();
 
 				auto get_total = [] (decltype (bootstrap_weights.second) const & reps) -> nano::uint128_union {
@@ -408,7 +408,7 @@ int main (int argc, char * const * argv)
 			auto transaction (node->store.tx_begin_read ());
 			nano::uint128_t total;
 			auto rep_amounts = node->ledger.cache.rep_weights.get_rep_amounts ();
-			std::map<nano::account, nano::uint128_t> ordered_reps (rep_amounts.begin (), rep_amounts.end ());
+			std::map<nano::account, nano::uint128_t> ordered_reps (rep_amounts->begin (), rep_amounts->end ());
 			for (auto const & rep : ordered_reps)
 			{
 				total += rep.second;
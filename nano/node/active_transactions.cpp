@@ -21,8 +21,6 @@ nano::active_transactions::active_transactions (nano::node & node_a, nano::confi
 	recently_cemented{ node.config.confirmation_history_size },
 	election_time_to_live{ node_a.network_params.network.is_dev_network () ? 0s : 2s }
 {
-	count_by_behavior.fill (0); // Zero initialize array
-
 	// Register a callback which will get called after a block is cemented
 	confirmation_height_processor.add_cemented_observer ([this] (std::shared_ptr<nano::block> const & callback_block_a) {
 		this->block_cemented_callback (callback_block_a);
@@ -265,11 +263,10 @@ int64_t nano::active_transactions::limit (nano::election_behavior behavior) cons
 
 int64_t nano::active_transactions::vacancy (nano::election_behavior behavior) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
 	switch (behavior)
 	{
 		case nano::election_behavior::normal:
-			return limit () - static_cast<int64_t> (roots.size ());
+			return limit () - static_cast<int64_t> (roots_size.load ());
 		case nano::election_behavior::hinted:
 		case nano::election_behavior::optimistic:
 			return limit (behavior) - count_by_behavior[behavior];
@@ -282,11 +279,10 @@ void nano::active_transactions::request_confirm (nano::unique_lock<nano::mutex>
 {
 	debug_assert (lock_a.owns_lock ());
 
-	std::size_t const this_loop_target_l (roots.size ());
-	auto const elections_l{ list_active_impl (this_loop_target_l) };
-
 	lock_a.unlock ();
 
+	auto const elections_l{ list_active_impl (std::numeric_limits<std::size_t>::max ()) };
+
 	nano::confirmation_solicitor solicitor (node.network, node.config);
 	solicitor.prepare (node.rep_crawler.principal_representatives (std::numeric_limits<std::size_t>::max ()));
 
@@ -315,10 +311,10 @@ void nano::active_transactions::request_confirm (nano::unique_lock<nano::mutex>
 	lock_a.lock ();
 }
 
-void nano::active_transactions::cleanup_election (nano::unique_lock<nano::mutex> & lock_a, std::shared_ptr<nano::election> election)
+void nano::active_transactions::cleanup_election (nano::unique_lock<nano::mutex> & lock_a, roots_shard & shard, std::shared_ptr<nano::election> election)
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (lock_a.owns_lock ());
+	debug_assert (lock_a.mutex () == &shard.mutex);
 	debug_assert (!election->confirmed () || recently_confirmed.exists (election->qualified_root));
 
 	// Keep track of election count by election type
@@ -328,12 +324,15 @@ void nano::active_transactions::cleanup_election (nano::unique_lock<nano::mutex>
 	auto blocks_l = election->blocks ();
 	for (auto const & [hash, block] : blocks_l)
 	{
-		auto erased (blocks.erase (hash));
+		auto & blocks_shard_l = shard_for (hash);
+		nano::lock_guard<nano::mutex> guard{ blocks_shard_l.mutex };
+		auto erased (blocks_shard_l.blocks.erase (hash));
 		(void)erased;
 		debug_assert (erased == 1);
 	}
 
-	roots.get<tag_root> ().erase (roots.get<tag_root> ().find (election->qualified_root));
+	shard.roots.get<tag_root> ().erase (shard.roots.get<tag_root> ().find (election->qualified_root));
+	--roots_size;
 
 	node.stats.inc (completion_type (*election), to_stat_detail (election->behavior ()));
 	node.logger.trace (nano::log::type::active_transactions, nano::log::detail::active_stopped, nano::log::arg{ "election", election });
@@ -373,22 +372,31 @@ nano::stat::type nano::active_transactions::completion_type (nano::election cons
 
 std::vector<std::shared_ptr<nano::election>> nano::active_transactions::list_active (std::size_t max_a)
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
 	return list_active_impl (max_a);
 }
 
 std::vector<std::shared_ptr<nano::election>> nano::active_transactions::list_active_impl (std::size_t max_a) const
 {
-	std::vector<std::shared_ptr<nano::election>> result_l;
-	result_l.reserve (std::min (max_a, roots.size ()));
+	// Every shard is ordered oldest first, so the oldest `max_a` elections overall are among the first `max_a` of each shard
+	std::vector<std::pair<uint64_t, std::shared_ptr<nano::election>>> entries;
+	for (auto const & shard : roots_shards)
 	{
-		auto & sorted_roots_l (roots.get<tag_sequenced> ());
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		auto & sorted_roots_l (shard.roots.get<tag_sequenced> ());
 		std::size_t count_l{ 0 };
 		for (auto i = sorted_roots_l.begin (), n = sorted_roots_l.end (); i != n && count_l < max_a; ++i, ++count_l)
 		{
-			result_l.push_back (i->election);
+			entries.emplace_back (i->sequence, i->election);
 		}
 	}
+	std::sort (entries.begin (), entries.end (), [] (auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+
+	std::vector<std::shared_ptr<nano::election>> result_l;
+	result_l.reserve (std::min (max_a, entries.size ()));
+	for (auto i = entries.begin (), n = entries.end (); i != n && result_l.size () < max_a; ++i)
+	{
+		result_l.push_back (std::move (i->second));
+	}
 	return result_l;
 }
 
@@ -429,20 +437,24 @@ void nano::active_transactions::trim ()
 
 nano::election_insertion_result nano::active_transactions::insert (std::shared_ptr<nano::block> const & block_a, nano::election_behavior election_behavior_a)
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
 	debug_assert (block_a);
 	debug_assert (block_a->has_sideband ());
 	nano::election_insertion_result result;
 
-	if (stopped)
 	{
-		return result;
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (stopped)
+		{
+			return result;
+		}
 	}
 
 	auto const root = block_a->qualified_root ();
 	auto const hash = block_a->hash ();
-	auto const existing = roots.get<tag_root> ().find (root);
-	if (existing == roots.get<tag_root> ().end ())
+	auto & shard = shard_for (root);
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
+	auto const existing = shard.roots.get<tag_root> ().find (root);
+	if (existing == shard.roots.get<tag_root> ().end ())
 	{
 		if (!recently_confirmed.exists (root))
 		{
@@ -452,8 +464,13 @@ nano::election_insertion_result nano::active_transactions::insert (std::shared_p
 				node.online_reps.observe (rep_a);
 			};
 			result.election = nano::make_shared<nano::election> (node, block_a, nullptr, observe_rep_cb, election_behavior_a);
-			roots.get<tag_root> ().emplace (nano::active_transactions::conflict_info{ root, result.election });
-			blocks.emplace (hash, result.election);
+			shard.roots.get<tag_root> ().emplace (nano::active_transactions::conflict_info{ root, result.election, next_sequence++ });
+			++roots_size;
+			{
+				auto & blocks_shard_l = shard_for (hash);
+				nano::lock_guard<nano::mutex> guard{ blocks_shard_l.mutex };
+				blocks_shard_l.blocks.emplace (hash, result.election);
+			}
 
 			// Keep track of election count by election type
 			debug_assert (count_by_behavior[result.election->behavior ()] >= 0);
@@ -508,24 +525,30 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> con
 	std::vector<std::pair<std::shared_ptr<nano::election>, nano::block_hash>> process;
 	std::vector<nano::block_hash> inactive; // Hashes that should be added to inactive vote cache
 
+	for (auto const & hash : vote_a->hashes)
 	{
-		nano::unique_lock<nano::mutex> lock{ mutex };
-		for (auto const & hash : vote_a->hashes)
+		std::shared_ptr<nano::election> election;
 		{
-			auto existing (blocks.find (hash));
-			if (existing != blocks.end ())
+			auto & shard = shard_for (hash);
+			nano::lock_guard<nano::mutex> guard{ shard.mutex };
+			auto existing (shard.blocks.find (hash));
+			if (existing != shard.blocks.end ())
 			{
-				process.emplace_back (existing->second, hash);
-			}
-			else if (!recently_confirmed.exists (hash))
-			{
-				inactive.emplace_back (hash);
-			}
-			else
-			{
-				++recently_confirmed_counter;
+				election = existing->second;
 			}
 		}
+		if (election)
+		{
+			process.emplace_back (std::move (election), hash);
+		}
+		else if (!recently_confirmed.exists (hash))
+		{
+			inactive.emplace_back (hash);
+		}
+		else
+		{
+			++recently_confirmed_counter;
+		}
 	}
 
 	// Process inactive votes outside of the critical section
@@ -565,28 +588,30 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> con
 
 bool nano::active_transactions::active (nano::qualified_root const & root_a) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return roots.get<tag_root> ().find (root_a) != roots.get<tag_root> ().end ();
+	auto & shard = shard_for (root_a);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	return shard.roots.get<tag_root> ().find (root_a) != shard.roots.get<tag_root> ().end ();
 }
 
 bool nano::active_transactions::active (nano::block const & block_a) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return roots.get<tag_root> ().find (block_a.qualified_root ()) != roots.get<tag_root> ().end () && blocks.find (block_a.hash ()) != blocks.end ();
+	return active (block_a.qualified_root ()) && active (block_a.hash ());
 }
 
 bool nano::active_transactions::active (const nano::block_hash & hash) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return blocks.find (hash) != blocks.end ();
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	return shard.blocks.find (hash) != shard.blocks.end ();
 }
 
 std::shared_ptr<nano::election> nano::active_transactions::election (nano::qualified_root const & root_a) const
 {
 	std::shared_ptr<nano::election> result;
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto existing = roots.get<tag_root> ().find (root_a);
-	if (existing != roots.get<tag_root> ().end ())
+	auto & shard = shard_for (root_a);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	auto existing = shard.roots.get<tag_root> ().find (root_a);
+	if (existing != shard.roots.get<tag_root> ().end ())
 	{
 		result = existing->election;
 	}
@@ -596,9 +621,10 @@ std::shared_ptr<nano::election> nano::active_transactions::election (nano::quali
 std::shared_ptr<nano::block> nano::active_transactions::winner (nano::block_hash const & hash_a) const
 {
 	std::shared_ptr<nano::block> result;
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	auto existing = blocks.find (hash_a);
-	if (existing != blocks.end ())
+	auto & shard = shard_for (hash_a);
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
+	auto existing = shard.blocks.find (hash_a);
+	if (existing != shard.blocks.end ())
 	{
 		auto election = existing->second;
 		lock.unlock ();
@@ -614,58 +640,77 @@ void nano::active_transactions::erase (nano::block const & block_a)
 
 void nano::active_transactions::erase (nano::qualified_root const & root_a)
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	auto root_it (roots.get<tag_root> ().find (root_a));
-	if (root_it != roots.get<tag_root> ().end ())
+	auto & shard = shard_for (root_a);
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
+	auto root_it (shard.roots.get<tag_root> ().find (root_a));
+	if (root_it != shard.roots.get<tag_root> ().end ())
 	{
-		cleanup_election (lock, root_it->election);
+		cleanup_election (lock, shard, root_it->election);
 	}
 }
 
 void nano::active_transactions::erase_hash (nano::block_hash const & hash_a)
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	[[maybe_unused]] auto erased (blocks.erase (hash_a));
+	auto & shard = shard_for (hash_a);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	[[maybe_unused]] auto erased (shard.blocks.erase (hash_a));
 	debug_assert (erased == 1);
 }
 
 void nano::active_transactions::erase_oldest ()
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	if (!roots.empty ())
+	// Find the shard holding the oldest election, each shard is ordered oldest first
+	roots_shard * oldest_shard = nullptr;
+	uint64_t oldest_sequence = std::numeric_limits<uint64_t>::max ();
+	for (auto & shard : roots_shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		if (!shard.roots.empty () && shard.roots.get<tag_sequenced> ().front ().sequence < oldest_sequence)
+		{
+			oldest_sequence = shard.roots.get<tag_sequenced> ().front ().sequence;
+			oldest_shard = &shard;
+		}
+	}
+	if (oldest_shard != nullptr)
 	{
-		auto item = roots.get<tag_sequenced> ().front ();
-		cleanup_election (lock, item.election);
+		nano::unique_lock<nano::mutex> lock{ oldest_shard->mutex };
+		// The shard may have changed while unlocked, erase whatever is oldest in it now
+		if (!oldest_shard->roots.empty ())
+		{
+			auto item = oldest_shard->roots.get<tag_sequenced> ().front ();
+			cleanup_election (lock, *oldest_shard, item.election);
+		}
 	}
 }
 
 bool nano::active_transactions::empty () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return roots.empty ();
+	return roots_size == 0;
 }
 
 std::size_t nano::active_transactions::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return roots.size ();
+	return roots_size;
 }
 
 bool nano::active_transactions::publish (std::shared_ptr<nano::block> const & block_a)
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	auto existing (roots.get<tag_root> ().find (block_a->qualified_root ()));
+	auto & shard = shard_for (block_a->qualified_root ());
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
+	auto existing (shard.roots.get<tag_root> ().find (block_a->qualified_root ()));
 	auto result (true);
-	if (existing != roots.get<tag_root> ().end ())
+	if (existing != shard.roots.get<tag_root> ().end ())
 	{
 		auto election (existing->election);
 		lock.unlock ();
 		result = election->publish (block_a);
 		if (!result)
 		{
-			lock.lock ();
-			blocks.emplace (block_a->hash (), election);
-			lock.unlock ();
+			{
+				auto & blocks_shard_l = shard_for (block_a->hash ());
+				nano::lock_guard<nano::mutex> guard{ blocks_shard_l.mutex };
+				blocks_shard_l.blocks.emplace (block_a->hash (), election);
+			}
 			if (auto const cache = node.vote_cache.find (block_a->hash ()); cache)
 			{
 				cache->fill (election);
@@ -682,9 +727,10 @@ boost::optional<nano::election_status_type> nano::active_transactions::confirm_b
 	auto const hash = block_a->hash ();
 	std::shared_ptr<nano::election> election = nullptr;
 	{
-		nano::lock_guard<nano::mutex> guard{ mutex };
-		auto existing = blocks.find (hash);
-		if (existing != blocks.end ())
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		auto existing = shard.blocks.find (hash);
+		if (existing != shard.blocks.end ())
 		{
 			election = existing->second;
 		}
@@ -719,21 +765,56 @@ std::size_t nano::active_transactions::election_winner_details_size ()
 
 void nano::active_transactions::clear ()
 {
+	for (auto & shard : roots_shards)
 	{
-		nano::lock_guard<nano::mutex> guard{ mutex };
-		blocks.clear ();
-		roots.clear ();
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		roots_size -= shard.roots.size ();
+		for (auto const & info : shard.roots)
+		{
+			count_by_behavior[info.election->behavior ()]--;
+		}
+		shard.roots.clear ();
+	}
+	for (auto & shard : blocks_shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.blocks.clear ();
 	}
 	vacancy_update ();
 }
 
+auto nano::active_transactions::shard_for (nano::qualified_root const & root) -> roots_shard &
+{
+	return roots_shards[std::hash<nano::qualified_root>{}(root) % shard_count];
+}
+
+auto nano::active_transactions::shard_for (nano::qualified_root const & root) const -> roots_shard const &
+{
+	return roots_shards[std::hash<nano::qualified_root>{}(root) % shard_count];
+}
+
+auto nano::active_transactions::shard_for (nano::block_hash const & hash) -> blocks_shard &
+{
+	return blocks_shards[std::hash<nano::block_hash>{}(hash) % shard_count];
+}
+
+auto nano::active_transactions::shard_for (nano::block_hash const & hash) const -> blocks_shard const &
+{
+	return blocks_shards[std::hash<nano::block_hash>{}(hash) % shard_count];
+}
+
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (active_transactions & active_transactions, std::string const & name)
 {
-	nano::lock_guard<nano::mutex> guard{ active_transactions.mutex };
+	std::size_t blocks_count = 0;
+	for (auto & shard : active_transactions.blocks_shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		blocks_count += shard.blocks.size ();
+	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", active_transactions.roots.size (), sizeof (decltype (active_transactions.roots)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", active_transactions.blocks.size (), sizeof (decltype (active_transactions.blocks)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "roots", active_transactions.size (), sizeof (decltype (active_transactions.roots_shards[0].roots)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (active_transactions.blocks_shards[0].blocks)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "election_winner_details", active_transactions.election_winner_details_size (), sizeof (decltype (active_transactions.election_winner_details)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "normal", static_cast<std::size_t> (active_transactions.count_by_behavior[nano::election_behavior::normal]), 0 }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hinted", static_cast<std::size_t> (active_transactions.count_by_behavior[nano::election_behavior::hinted]), 0 }));
@@ -12,6 +12,8 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <memory>
@@ -99,6 +101,7 @@ public: // Container info
 /**
  * Core class for determining consensus
  * Holds all active blocks i.e. recently added blocks that need confirmation
+ * Elections are kept in lock-striped shards so that vote processing, insertion and the request loop do not serialise on a single mutex
  */
 class active_transactions final
 {
@@ -108,6 +111,8 @@ private: // Elections
 	public:
 		nano::qualified_root root;
 		std::shared_ptr<nano::election> election;
+		/** Global insertion order, used to merge shards back into a single oldest-first view */
+		uint64_t sequence;
 	};
 
 	friend class nano::election;
@@ -127,8 +132,37 @@ private: // Elections
 			mi::member<conflict_info, nano::qualified_root, &conflict_info::root>>
 	>>;
 	// clang-format on
-	ordered_roots roots;
-	std::unordered_map<nano::block_hash, std::shared_ptr<nano::election>> blocks;
+
+	/*
+	 * Elections are striped by qualified root and election blocks by block hash, each stripe guarded by its own mutex.
+	 * When both are needed a roots shard is always locked before a blocks shard.
+	 */
+	class roots_shard final
+	{
+	public:
+		ordered_roots roots;
+		mutable nano::mutex mutex{ mutex_identifier (mutexes::active) };
+	};
+
+	class blocks_shard final
+	{
+	public:
+		std::unordered_map<nano::block_hash, std::shared_ptr<nano::election>> blocks;
+		mutable nano::mutex mutex{ mutex_identifier (mutexes::active) };
+	};
+
+	static std::size_t constexpr shard_count = 16;
+	std::array<roots_shard, shard_count> roots_shards;
+	std::array<blocks_shard, shard_count> blocks_shards;
+
+	roots_shard & shard_for (nano::qualified_root const &);
+	roots_shard const & shard_for (nano::qualified_root const &) const;
+	blocks_shard & shard_for (nano::block_hash const &);
+	blocks_shard const & shard_for (nano::block_hash const &) const;
+
+	/** Total number of elections over all shards */
+	std::atomic<std::size_t> roots_size{ 0 };
+	std::atomic<uint64_t> next_sequence{ 0 };
 
 public:
 	active_transactions (nano::node &, nano::confirmation_height_processor &, nano::block_processor &);
@@ -185,10 +219,10 @@ private:
 	void request_loop ();
 	void request_confirm (nano::unique_lock<nano::mutex> &);
 	void erase (nano::qualified_root const &);
-	// Erase all blocks from active and, if not confirmed, clear digests from network filters
-	void cleanup_election (nano::unique_lock<nano::mutex> & lock_a, std::shared_ptr<nano::election>);
+	// Erase all blocks from active and, if not confirmed, clear digests from network filters. Lock of the election roots shard must be held
+	void cleanup_election (nano::unique_lock<nano::mutex> & lock_a, roots_shard &, std::shared_ptr<nano::election>);
 	nano::stat::type completion_type (nano::election const & election) const;
-	// Returns a list of elections sorted by difficulty, mutex must be locked
+	// Returns a list of elections, oldest first
 	std::vector<std::shared_ptr<nano::election>> list_active_impl (std::size_t) const;
 	/**
 	 * Checks if vote passes minimum representative weight threshold and adds it to inactive vote cache
@@ -215,6 +249,7 @@ public:
 
 	// TODO: This mutex is currently public because many tests access it
 	// TODO: This is bad. Remove the need to explicitly lock this from any code outside of this class
+	// Only guards the request loop state, elections are guarded by the shard mutexes
 	mutable nano::mutex mutex{ mutex_identifier (mutexes::active) };
 
 private:
@@ -225,7 +260,7 @@ private:
 	std::chrono::seconds const election_time_to_live;
 
 	/** Keeps track of number of elections by election behavior (normal, hinted, optimistic) */
-	nano::enum_array<nano::election_behavior, int64_t> count_by_behavior;
+	nano::enum_array<nano::election_behavior, std::atomic<int64_t>> count_by_behavior;
 
 	nano::condition_variable condition;
 	bool stopped{ false };
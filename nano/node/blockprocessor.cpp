@@ -24,6 +24,14 @@ nano::block_processor::block_processor (nano::node & node_a, nano::write_databas
 		nano::thread_role::set (nano::thread_role::name::block_processing);
 		this->process_blocks ();
 	});
+	auto const prevalidation_thread_count = std::max (1u, node.config.signature_checker_threads);
+	for (auto i = 0u; i < prevalidation_thread_count; ++i)
+	{
+		prevalidation_threads.emplace_back ([this] () {
+			nano::thread_role::set (nano::thread_role::name::block_prevalidation);
+			this->run_prevalidation ();
+		});
+	}
 }
 
 void nano::block_processor::stop ()
@@ -35,12 +43,16 @@ void nano::block_processor::stop ()
 	condition.notify_all ();
 	blocking.stop ();
 	nano::join_or_pass (processing_thread);
+	for (auto & thread : prevalidation_threads)
+	{
+		nano::join_or_pass (thread);
+	}
 }
 
 std::size_t nano::block_processor::size ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	return blocks.size () + forced.size ();
+	return incoming.size () + prevalidating + blocks.size () + forced.size ();
 }
 
 bool nano::block_processor::full ()
@@ -60,19 +72,38 @@ void nano::block_processor::add (std::shared_ptr<nano::block> const & block)
 		node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::overfill);
 		return;
 	}
-	if (node.network_params.work.validate_entry (*block)) // true => error
+	// Work is checked by prevalidation threads
+	add_impl (block, /* validate work */ true);
+	return;
+}
+
+void nano::block_processor::add (std::vector<std::shared_ptr<nano::block>> const & batch)
+{
+	std::size_t added = 0;
 	{
-		node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::insufficient_work);
-		return;
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & block : batch)
+		{
+			if (incoming.size () + prevalidating + blocks.size () + forced.size () >= node.flags.block_processor_full_size)
+			{
+				break;
+			}
+			// Work is checked by prevalidation threads
+			incoming.push_back ({ block, nano::signature_verification::unknown, /* validate work */ true });
+			++added;
+		}
 	}
-	add_impl (block);
-	return;
+	if (added < batch.size ())
+	{
+		node.stats.add (nano::stat::type::blockprocessor, nano::stat::detail::overfill, nano::stat::dir::in, batch.size () - added);
+	}
+	condition.notify_all ();
 }
 
 std::optional<nano::process_return> nano::block_processor::add_blocking (std::shared_ptr<nano::block> const & block)
 {
 	auto future = blocking.insert (block);
-	add_impl (block);
+	add_impl (block, /* validate work */ false);
 	condition.notify_all ();
 	std::optional<nano::process_return> result;
 	try
@@ -178,23 +209,166 @@ bool nano::block_processor::have_blocks_ready ()
 bool nano::block_processor::have_blocks ()
 {
 	debug_assert (!mutex.try_lock ());
-	return have_blocks_ready ();
+	return have_blocks_ready () || !incoming.empty () || prevalidating > 0;
 }
 
-void nano::block_processor::add_impl (std::shared_ptr<nano::block> block)
+void nano::block_processor::add_impl (std::shared_ptr<nano::block> block, bool validate_work)
 {
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
-		blocks.emplace_back (block);
+		incoming.push_back ({ block, nano::signature_verification::unknown, validate_work });
 	}
 	condition.notify_all ();
 }
 
+void nano::block_processor::run_prevalidation ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		if (!incoming.empty ())
+		{
+			auto const sequence = next_sequence++;
+			std::deque<context> batch;
+			auto const max_batch_size = prevalidation_batch_size ();
+			while (!incoming.empty () && batch.size () < max_batch_size)
+			{
+				batch.push_back (std::move (incoming.front ()));
+				incoming.pop_front ();
+			}
+			prevalidating += batch.size ();
+			lock.unlock ();
+
+			prevalidate (sequence, std::move (batch));
+
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+void nano::block_processor::prevalidate (uint64_t sequence, std::deque<context> batch_a)
+{
+	auto batch = std::make_shared<std::deque<context>> (std::move (batch_a));
+	nano::signature_check_set signatures;
+	// Position in the batch of each signature in the set
+	std::vector<std::size_t> positions;
+	// Work of the whole batch is validated at once so the hashes are computed several at a time
+	std::vector<nano::block const *> work_blocks;
+	for (auto const & item : *batch)
+	{
+		if (item.validate_work)
+		{
+			work_blocks.push_back (item.block.get ());
+		}
+	}
+	auto const insufficient_work = node.network_params.work.validate_entries (work_blocks);
+	{
+		auto transaction = node.store.tx_begin_read ();
+		std::size_t work_index = 0;
+		for (std::size_t i = 0; i < batch->size (); ++i)
+		{
+			auto & item = (*batch)[i];
+			auto const & block = *item.block;
+			block.hash (); // Cache the hash so it is not computed under the write transaction
+			if (item.validate_work && insufficient_work[work_index++])
+			{
+				node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::insufficient_work);
+				item.dropped = true;
+				continue;
+			}
+			// Blocks whose signer cannot be determined yet are left for the ledger to check
+			auto const signer = block_signer (transaction, block);
+			if (!signer.is_zero ())
+			{
+				signatures.add (signer, block.hash (), block.block_signature ());
+				positions.push_back (i);
+			}
+			// Warm up the records the ledger is going to read for this block
+			if (!block.account ().is_zero ())
+			{
+				node.ledger.account_info (transaction, block.account ());
+			}
+			if (!block.previous ().is_zero ())
+			{
+				node.store.block.exists (transaction, block.previous ());
+			}
+		}
+	}
+	node.stats.add (nano::stat::type::blockprocessor, nano::stat::detail::prevalidated, nano::stat::dir::in, batch->size ());
+
+	if (signatures.empty ())
+	{
+		release (sequence, *batch);
+		return;
+	}
+	bool stopped_l = node.checker.add (std::move (signatures), [this, sequence, batch, positions] (nano::signature_check_set & signatures) {
+		for (std::size_t i = 0; i < positions.size (); ++i)
+		{
+			auto & item = (*batch)[positions[i]];
+			item.verification = signatures.valid (i) ? nano::signature_verification::valid : verify_epoch_signature (*item.block);
+		}
+		release (sequence, *batch);
+	});
+	if (stopped_l)
+	{
+		// Signatures are left for the ledger to check
+		release (sequence, *batch);
+	}
+}
+
+void nano::block_processor::release (uint64_t sequence, std::deque<context> & batch)
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		prevalidated.emplace (sequence, std::move (batch));
+		// Batches are released in the order they were taken to preserve block arrival order, dependent blocks would otherwise end up in unchecked
+		while (!prevalidated.empty () && prevalidated.begin ()->first == next_release)
+		{
+			auto & ready = prevalidated.begin ()->second;
+			prevalidating -= ready.size ();
+			for (auto & item : ready)
+			{
+				if (!item.dropped)
+				{
+					blocks.push_back (std::move (item));
+				}
+			}
+			prevalidated.erase (prevalidated.begin ());
+			++next_release;
+		}
+	}
+	condition.notify_all ();
+}
+
+nano::account nano::block_processor::block_signer (store::transaction const & transaction, nano::block const & block) const
+{
+	// Open and state blocks carry their account, legacy send/receive/change blocks are signed by the account owning the previous block
+	return !block.account ().is_zero () ? block.account () : node.ledger.account_safe (transaction, block.previous ());
+}
+
+nano::signature_verification nano::block_processor::verify_epoch_signature (nano::block const & block) const
+{
+	if (block.type () == nano::block_type::state && node.ledger.is_epoch_link (block.link ()) && !nano::validate_message (node.ledger.epoch_signer (block.link ()), block.hash (), block.block_signature ()))
+	{
+		return nano::signature_verification::valid_epoch;
+	}
+	return nano::signature_verification::invalid;
+}
+
+std::size_t nano::block_processor::prevalidation_batch_size () const
+{
+	return node.flags.block_processor_verification_size != 0 ? node.flags.block_processor_verification_size : 256;
+}
+
 auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock_a) -> std::deque<processed_t>
 {
 	std::deque<processed_t> processed;
 	auto scoped_write_guard = write_database_queue.wait (nano::writer::process_batch);
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending }));
 	nano::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -214,9 +388,11 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 		std::shared_ptr<nano::block> block;
 		nano::block_hash hash (0);
 		bool force (false);
+		auto verification = nano::signature_verification::unknown;
 		if (forced.empty ())
 		{
-			block = blocks.front ();
+			block = blocks.front ().block;
+			verification = blocks.front ().verification;
 			blocks.pop_front ();
 			hash = block->hash ();
 		}
@@ -234,7 +410,7 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 			rollback_competitor (transaction, *block);
 		}
 		number_of_blocks_processed++;
-		auto result = process_one (transaction, block, force);
+		auto result = process_one (transaction, block, force, verification);
 		processed.emplace_back (result, block);
 		lock_a.lock ();
 	}
@@ -248,11 +424,11 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	return processed;
 }
 
-nano::process_return nano::block_processor::process_one (store::write_transaction const & transaction_a, std::shared_ptr<nano::block> block, bool const forced_a)
+nano::process_return nano::block_processor::process_one (store::write_transaction const & transaction_a, std::shared_ptr<nano::block> block, bool const forced_a, nano::signature_verification const verification_a)
 {
 	nano::process_return result;
 	auto hash (block->hash ());
-	result = node.ledger.process (transaction_a, *block);
+	result = node.ledger.process (transaction_a, *block, verification_a);
 
 	node.stats.inc (nano::stat::type::blockprocessor, to_stat_detail (result.code));
 	node.logger.trace (nano::log::type::blockprocessor, nano::log::detail::block_processed,
@@ -347,16 +523,22 @@ void nano::block_processor::queue_unchecked (store::write_transaction const & tr
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_processor & block_processor, std::string const & name)
 {
+	std::size_t incoming_count;
+	std::size_t prevalidating_count;
 	std::size_t blocks_count;
 	std::size_t forced_count;
 
 	{
 		nano::lock_guard<nano::mutex> guard{ block_processor.mutex };
+		incoming_count = block_processor.incoming.size ();
+		prevalidating_count = block_processor.prevalidating;
 		blocks_count = block_processor.blocks.size ();
 		forced_count = block_processor.forced.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "incoming", incoming_count, sizeof (decltype (block_processor.incoming)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "prevalidating", prevalidating_count, sizeof (decltype (block_processor.incoming)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
 	return composite;
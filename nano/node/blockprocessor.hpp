@@ -6,12 +6,16 @@
 #include <nano/secure/common.hpp>
 
 #include <chrono>
+#include <deque>
 #include <future>
+#include <map>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace nano::store
 {
+class transaction;
 class write_transaction;
 }
 
@@ -23,6 +27,9 @@ class write_database_queue;
 /**
  * Processing blocks is a potentially long IO operation.
  * This class isolates block insertion from other operations like servicing network operations
+ * Processing is pipelined: a pool of prevalidation threads does the stateless work (hashing, work checks, warming up ledger reads),
+ * signatures are verified in batches by the node signature checker and blocks are then handed over in arrival order
+ * to a single thread that inserts them into the ledger under the write transaction
  */
 class block_processor final
 {
@@ -33,6 +40,8 @@ public:
 	bool full ();
 	bool half_full ();
 	void add (std::shared_ptr<nano::block> const &);
+	/** Queues a whole batch under a single lock, blocks that do not fit once the processor is full are dropped */
+	void add (std::vector<std::shared_ptr<nano::block>> const &);
 	std::optional<nano::process_return> add_blocking (std::shared_ptr<nano::block> const & block);
 	void force (std::shared_ptr<nano::block> const &);
 	bool should_log ();
@@ -53,22 +62,51 @@ private:
 	blocking_observer blocking;
 
 private:
+	class context
+	{
+	public:
+		std::shared_ptr<nano::block> block;
+		nano::signature_verification verification{ nano::signature_verification::unknown };
+		/** Blocks received through `add ()` still need their work checked */
+		bool validate_work{ false };
+		/** Set by prevalidation for blocks that should not reach the ledger */
+		bool dropped{ false };
+	};
+
 	// Roll back block in the ledger that conflicts with 'block'
 	void rollback_competitor (store::write_transaction const & transaction, nano::block const & block);
-	nano::process_return process_one (store::write_transaction const &, std::shared_ptr<nano::block> block, bool const = false);
+	nano::process_return process_one (store::write_transaction const &, std::shared_ptr<nano::block> block, bool const = false, nano::signature_verification const = nano::signature_verification::unknown);
 	void queue_unchecked (store::write_transaction const &, nano::hash_or_account const &);
 	std::deque<processed_t> process_batch (nano::unique_lock<nano::mutex> &);
-	void add_impl (std::shared_ptr<nano::block> block);
+	void add_impl (std::shared_ptr<nano::block> block, bool validate_work);
+	void run_prevalidation ();
+	void prevalidate (uint64_t sequence, std::deque<context>);
+	/** Queues a prevalidated batch for insertion once all batches taken before it are released */
+	void release (uint64_t sequence, std::deque<context> &);
+	nano::account block_signer (store::transaction const &, nano::block const &) const;
+	/** Checks blocks that failed signature verification against their epoch signer */
+	nano::signature_verification verify_epoch_signature (nano::block const &) const;
+	std::size_t prevalidation_batch_size () const;
 	bool stopped{ false };
 	bool active{ false };
 	std::chrono::steady_clock::time_point next_log;
-	std::deque<std::shared_ptr<nano::block>> blocks;
+	/** Blocks waiting for prevalidation */
+	std::deque<context> incoming;
+	/** Prevalidated batches waiting for all batches taken before them to finish, keyed by the order they were taken from `incoming` */
+	std::map<uint64_t, std::deque<context>> prevalidated;
+	uint64_t next_sequence{ 0 };
+	uint64_t next_release{ 0 };
+	/** Number of blocks taken from `incoming` that are not yet queued in `blocks` */
+	std::size_t prevalidating{ 0 };
+	/** Prevalidated blocks ready to be inserted into the ledger */
+	std::deque<context> blocks;
 	std::deque<std::shared_ptr<nano::block>> forced;
 	nano::condition_variable condition;
 	nano::node & node;
 	nano::write_database_queue & write_database_queue;
 	nano::mutex mutex{ mutex_identifier (mutexes::block_processor) };
 	std::thread processing_thread;
+	std::vector<std::thread> prevalidation_threads;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (block_processor & block_processor, std::string const & name);
 };
@@ -34,6 +34,8 @@ public:
 	std::size_t throttle_coefficient{ 16 };
 	nano::millis_t throttle_wait{ 100 };
 	std::size_t block_wait_count{ 1000 };
+	// Number of threads concurrently selecting accounts and sending requests
+	std::size_t threads{ 4 };
 
 	nano::account_sets_config account_sets;
 };
@@ -115,7 +115,7 @@ void nano::bootstrap_server::respond (nano::asc_pull_ack & response, std::shared
 		void operator() (nano::asc_pull_ack::blocks_payload const & pld)
 		{
 			stats.inc (nano::stat::type::bootstrap_server, nano::stat::detail::response_blocks, nano::stat::dir::out);
-			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.blocks.size ());
+			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.size ());
 		}
 		void operator() (nano::asc_pull_ack::account_info_payload const & pld)
 		{
@@ -218,16 +218,13 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_response (store::transaction
 {
 	debug_assert (count <= max_blocks); // Should be filtered out earlier
 
-	auto blocks = prepare_blocks (transaction, start_block, count);
-	debug_assert (blocks.size () <= count);
+	auto response_payload = prepare_blocks (transaction, start_block, count);
+	debug_assert (response_payload.size () <= count);
 
 	nano::asc_pull_ack response{ network_constants };
 	response.id = id;
 	response.type = nano::asc_pull_type::blocks;
-
-	nano::asc_pull_ack::blocks_payload response_payload{};
-	response_payload.blocks = blocks;
-	response.payload = response_payload;
+	response.payload = std::move (response_payload);
 
 	response.update_header ();
 	return response;
@@ -246,21 +243,22 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_empty_blocks_response (nano::
 	return response;
 }
 
-std::vector<std::shared_ptr<nano::block>> nano::bootstrap_server::prepare_blocks (store::transaction const & transaction, nano::block_hash start_block, std::size_t count) const
+nano::asc_pull_ack::blocks_payload nano::bootstrap_server::prepare_blocks (store::transaction const & transaction, nano::block_hash start_block, std::size_t count) const
 {
 	debug_assert (count <= max_blocks); // Should be filtered out earlier
 
-	std::vector<std::shared_ptr<nano::block>> result;
-	if (!start_block.is_zero ())
+	// Blocks are copied from the ledger in their network serialization, without decoding them
+	nano::asc_pull_ack::blocks_payload result{};
+	auto current = start_block;
+	while (!current.is_zero () && result.serialized_count < count)
 	{
-		std::shared_ptr<nano::block> current = store.block.get (transaction, start_block);
-		while (current && result.size () < count)
+		auto successor = store.block.get_serialized (transaction, current, result.serialized_blocks);
+		if (!successor)
 		{
-			result.push_back (current);
-
-			auto successor = current->sideband ().successor;
-			current = store.block.get (transaction, successor);
+			break;
 		}
+		++result.serialized_count;
+		current = *successor;
 	}
 	return result;
 }
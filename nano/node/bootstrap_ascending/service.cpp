@@ -22,61 +22,95 @@ nano::bootstrap_ascending::service::service (nano::node_config & config_a, nano:
 	ledger{ ledger_a },
 	network{ network_a },
 	stats{ stat_a },
-	accounts{ stats },
 	iterator{ ledger.store },
 	throttle{ compute_throttle_size () },
 	scoring{ config.bootstrap_ascending, config.network_params.network },
 	database_limiter{ config.bootstrap_ascending.database_requests_limit, 1.0 }
 {
-	// TODO: This is called from a very congested blockprocessor thread. Offload this work to a dedicated processing thread
+	for (std::size_t i = 0; i < accounts_shard_count; ++i)
+	{
+		accounts.push_back (std::make_unique<accounts_shard> (stats, shard_config (config.bootstrap_ascending.account_sets)));
+	}
+
+	// This is called from a very congested blockprocessor thread, only queue the batch here and inspect it on a dedicated thread
 	block_processor.batch_processed.add ([this] (auto const & batch) {
+		if (!inspecting)
 		{
-			nano::lock_guard<nano::mutex> lock{ mutex };
-
-			auto transaction = ledger.store.tx_begin_read ();
-			for (auto const & [result, block] : batch)
+			// Nothing drains the queue before the service is started
+			inspect (batch);
+			return;
+		}
+		{
+			nano::unique_lock<nano::mutex> lock{ inspect_mutex };
+			if (inspect_queue.size () >= max_inspect_queue)
 			{
-				debug_assert (block != nullptr);
-
-				inspect (transaction, result, *block);
+				// Results must be inspected in order, so the block processor waits for inspection to catch up
+				stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::overfill);
+				inspect_condition.wait (lock, [this] () { return stopped || inspect_queue.size () < max_inspect_queue; });
 			}
+			if (stopped)
+			{
+				return;
+			}
+			inspect_queue.push_back (batch);
 		}
-
-		condition.notify_all ();
+		inspect_condition.notify_all ();
 	});
 }
 
 nano::bootstrap_ascending::service::~service ()
 {
 	// All threads must be stopped before destruction
-	debug_assert (!thread.joinable ());
+	debug_assert (threads.empty ());
 	debug_assert (!timeout_thread.joinable ());
+	debug_assert (!inspect_thread.joinable ());
 }
 
 void nano::bootstrap_ascending::service::start ()
 {
-	debug_assert (!thread.joinable ());
+	debug_assert (threads.empty ());
 	debug_assert (!timeout_thread.joinable ());
+	debug_assert (!inspect_thread.joinable ());
 
-	thread = std::thread ([this] () {
-		nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
-		run ();
-	});
+	for (auto i = 0u; i < std::max<std::size_t> (1, config.bootstrap_ascending.threads); ++i)
+	{
+		threads.emplace_back ([this] () {
+			nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
+			run ();
+		});
+	}
 
 	timeout_thread = std::thread ([this] () {
 		nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
 		run_timeouts ();
 	});
+
+	inspecting = true;
+	inspect_thread = std::thread ([this] () {
+		nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
+		run_inspect ();
+	});
 }
 
 void nano::bootstrap_ascending::service::stop ()
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	stopped = true;
-	lock.unlock ();
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		stopped = true;
+	}
 	condition.notify_all ();
-	nano::join_or_pass (thread);
+	{
+		nano::lock_guard<nano::mutex> lock{ inspect_mutex };
+		inspect_queue.clear ();
+	}
+	inspect_condition.notify_all ();
+	for (auto & thread : threads)
+	{
+		nano::join_or_pass (thread);
+	}
+	threads.clear ();
 	nano::join_or_pass (timeout_thread);
+	nano::join_or_pass (inspect_thread);
 }
 
 void nano::bootstrap_ascending::service::send (std::shared_ptr<nano::transport::channel> channel, async_tag tag)
@@ -105,14 +139,24 @@ void nano::bootstrap_ascending::service::send (std::shared_ptr<nano::transport::
 
 std::size_t nano::bootstrap_ascending::service::priority_size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return accounts.priority_size ();
+	std::size_t result = 0;
+	for (auto const & shard : accounts)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		result += shard->sets.priority_size ();
+	}
+	return result;
 }
 
 std::size_t nano::bootstrap_ascending::service::blocked_size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return accounts.blocked_size ();
+	std::size_t result = 0;
+	for (auto const & shard : accounts)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		result += shard->sets.blocked_size ();
+	}
+	return result;
 }
 
 std::size_t nano::bootstrap_ascending::service::score_size () const
@@ -136,10 +180,14 @@ void nano::bootstrap_ascending::service::inspect (store::transaction const & tx,
 			const auto account = ledger.account (tx, hash);
 			const auto is_send = ledger.is_send (tx, block);
 
-			// If we've inserted any block in to an account, unmark it as blocked
-			accounts.unblock (account);
-			accounts.priority_up (account);
-			accounts.timestamp (account, /* reset timestamp */ true);
+			{
+				auto & shard = shard_for (account);
+				nano::lock_guard<nano::mutex> lock{ shard.mutex };
+				// If we've inserted any block in to an account, unmark it as blocked
+				shard.sets.unblock (account);
+				shard.sets.priority_up (account);
+				shard.sets.timestamp (account, /* reset timestamp */ true);
+			}
 
 			if (is_send)
 			{
@@ -159,8 +207,10 @@ void nano::bootstrap_ascending::service::inspect (store::transaction const & tx,
 				}
 				if (!destination.is_zero ())
 				{
-					accounts.unblock (destination, hash); // Unblocking automatically inserts account into priority set
-					accounts.priority_up (destination);
+					auto & shard = shard_for (destination);
+					nano::lock_guard<nano::mutex> lock{ shard.mutex };
+					shard.sets.unblock (destination, hash); // Unblocking automatically inserts account into priority set
+					shard.sets.priority_up (destination);
 				}
 			}
 		}
@@ -171,7 +221,9 @@ void nano::bootstrap_ascending::service::inspect (store::transaction const & tx,
 			const auto source = block.source ().is_zero () ? block.link ().as_block_hash () : block.source ();
 
 			// Mark account as blocked because it is missing the source block
-			accounts.block (account, source);
+			auto & shard = shard_for (account);
+			nano::lock_guard<nano::mutex> lock{ shard.mutex };
+			shard.sets.block (account, source);
 
 			// TODO: Track stats
 		}
@@ -196,7 +248,7 @@ void nano::bootstrap_ascending::service::wait_blockprocessor ()
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped && block_processor.size () > config.bootstrap_ascending.block_wait_count)
 	{
-		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped; }); // Blockprocessor is relatively slow, sleeping here instead of using conditions
+		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped.load (); }); // Blockprocessor is relatively slow, sleeping here instead of using conditions
 	}
 }
 
@@ -206,17 +258,23 @@ std::shared_ptr<nano::transport::channel> nano::bootstrap_ascending::service::wa
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped && !(channel = scoring.channel ()))
 	{
-		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped; });
+		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped.load (); });
 	}
 	return channel;
 }
 
 nano::account nano::bootstrap_ascending::service::available_account ()
 {
+	// Every call starts from another shard so that concurrent requesting threads sample different parts of the priority set
+	auto const start = next_shard++;
+	for (std::size_t i = 0; i < accounts.size (); ++i)
 	{
-		auto account = accounts.next ();
+		auto & shard = *accounts[(start + i) % accounts.size ()];
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto account = shard.sets.next ();
 		if (!account.is_zero ())
 		{
+			shard.sets.timestamp (account);
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::next_priority);
 			return account;
 		}
@@ -224,9 +282,16 @@ nano::account nano::bootstrap_ascending::service::available_account ()
 
 	if (database_limiter.should_pass (1))
 	{
-		auto account = iterator.next ();
+		nano::account account{ 0 };
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			account = iterator.next ();
+		}
 		if (!account.is_zero ())
 		{
+			auto & shard = shard_for (account);
+			nano::lock_guard<nano::mutex> lock{ shard.mutex };
+			shard.sets.timestamp (account);
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::next_database);
 			return account;
 		}
@@ -238,19 +303,15 @@ nano::account nano::bootstrap_ascending::service::available_account ()
 
 nano::account nano::bootstrap_ascending::service::wait_available_account ()
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
 		auto account = available_account ();
 		if (!account.is_zero ())
 		{
-			accounts.timestamp (account);
 			return account;
 		}
-		else
-		{
-			condition.wait_for (lock, 100ms);
-		}
+		nano::unique_lock<nano::mutex> lock{ mutex };
+		condition.wait_for (lock, 100ms, [this] () { return stopped.load (); });
 	}
 	return { 0 };
 }
@@ -312,7 +373,7 @@ void nano::bootstrap_ascending::service::throttle_if_needed (nano::unique_lock<n
 	if (!iterator.warmup () && throttle.throttled ())
 	{
 		stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::throttled);
-		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped; });
+		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped.load (); });
 	}
 }
 
@@ -329,6 +390,43 @@ void nano::bootstrap_ascending::service::run ()
 	}
 }
 
+void nano::bootstrap_ascending::service::inspect (std::deque<std::pair<nano::process_return, std::shared_ptr<nano::block>>> const & batch)
+{
+	auto transaction = ledger.store.tx_begin_read ();
+	for (auto const & [result, block] : batch)
+	{
+		debug_assert (block != nullptr);
+
+		inspect (transaction, result, *block);
+	}
+	// Wake up requesting threads waiting for accounts to become available
+	condition.notify_all ();
+}
+
+void nano::bootstrap_ascending::service::run_inspect ()
+{
+	nano::unique_lock<nano::mutex> lock{ inspect_mutex };
+	while (!stopped)
+	{
+		if (!inspect_queue.empty ())
+		{
+			auto batch = std::move (inspect_queue.front ());
+			inspect_queue.pop_front ();
+			lock.unlock ();
+			// Wake up the block processor if it is waiting for room in the queue
+			inspect_condition.notify_all ();
+
+			inspect (batch);
+
+			lock.lock ();
+		}
+		else
+		{
+			inspect_condition.wait (lock);
+		}
+	}
+}
+
 void nano::bootstrap_ascending::service::run_timeouts ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
@@ -345,7 +443,7 @@ void nano::bootstrap_ascending::service::run_timeouts ()
 			on_timeout.notify (tag);
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::timeout);
 		}
-		condition.wait_for (lock, 1s, [this] () { return stopped; });
+		condition.wait_for (lock, 1s, [this] () { return stopped.load (); });
 	}
 }
 
@@ -398,8 +496,12 @@ void nano::bootstrap_ascending::service::process (const nano::asc_pull_ack::bloc
 		{
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::nothing_new);
 
+			{
+				auto & shard = shard_for (tag.account);
+				nano::lock_guard<nano::mutex> lock{ shard.mutex };
+				shard.sets.priority_down (tag.account);
+			}
 			nano::lock_guard<nano::mutex> lock{ mutex };
-			accounts.priority_down (tag.account);
 			throttle.add (false);
 		}
 		break;
@@ -494,8 +596,29 @@ void nano::bootstrap_ascending::service::track (async_tag const & tag)
 
 auto nano::bootstrap_ascending::service::info () const -> nano::bootstrap_ascending::account_sets::info_t
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return accounts.info ();
+	nano::bootstrap_ascending::account_sets::info_t result;
+	auto & [blocking, priorities] = result;
+	for (auto const & shard : accounts)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		auto [shard_blocking, shard_priorities] = shard->sets.info ();
+		blocking.insert (blocking.end (), shard_blocking.begin (), shard_blocking.end ());
+		priorities.insert (priorities.end (), shard_priorities.begin (), shard_priorities.end ());
+	}
+	return result;
+}
+
+auto nano::bootstrap_ascending::service::shard_for (nano::account const & account) -> accounts_shard &
+{
+	return *accounts[account.bytes[0] % accounts.size ()];
+}
+
+nano::account_sets_config nano::bootstrap_ascending::service::shard_config (nano::account_sets_config const & config)
+{
+	auto result = config;
+	result.priorities_max = std::max<std::size_t> (1, config.priorities_max / accounts_shard_count);
+	result.blocking_max = std::max<std::size_t> (1, config.blocking_max / accounts_shard_count);
+	return result;
 }
 
 std::size_t nano::bootstrap_ascending::service::compute_throttle_size () const
@@ -514,6 +637,22 @@ std::unique_ptr<nano::container_info_component> nano::bootstrap_ascending::servi
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "tags", tags.size (), sizeof (decltype (tags)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "throttle", throttle.size (), 0 }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "throttle_successes", throttle.successes (), 0 }));
-	composite->add_component (accounts.collect_container_info ("accounts"));
+
+	auto accounts_composite = std::make_unique<container_info_composite> ("accounts");
+	for (std::size_t i = 0; i < accounts.size (); ++i)
+	{
+		nano::lock_guard<nano::mutex> shard_lock{ accounts[i]->mutex };
+		accounts_composite->add_component (accounts[i]->sets.collect_container_info (std::to_string (i)));
+	}
+	composite->add_component (std::move (accounts_composite));
 	return composite;
 }
+
+/*
+ * accounts_shard
+ */
+
+nano::bootstrap_ascending::service::accounts_shard::accounts_shard (nano::stats & stats_a, nano::account_sets_config const & config_a) :
+	sets{ stats_a, config_a }
+{
+}
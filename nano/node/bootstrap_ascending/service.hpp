@@ -17,7 +17,10 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
+#include <deque>
 #include <thread>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -89,11 +92,13 @@ namespace bootstrap_ascending
 	private:
 		/* Inspects a block that has been processed by the block processor */
 		void inspect (store::transaction const &, nano::process_return const & result, nano::block const & block);
+		void inspect (std::deque<std::pair<nano::process_return, std::shared_ptr<nano::block>>> const & batch);
 
 		void throttle_if_needed (nano::unique_lock<nano::mutex> & lock);
 		void run ();
 		bool run_one ();
 		void run_timeouts ();
+		void run_inspect ();
 
 		/* Throttles requesting new blocks, not to overwhelm blockprocessor */
 		void wait_blockprocessor ();
@@ -131,7 +136,27 @@ namespace bootstrap_ascending
 		nano::bootstrap_ascending::account_sets::info_t info () const;
 
 	private:
-		nano::bootstrap_ascending::account_sets accounts;
+		/** Slice of the priority and blocking sets, accounts are assigned to shards by their first byte so each account lives in exactly one shard */
+		class accounts_shard
+		{
+		public:
+			accounts_shard (nano::stats &, nano::account_sets_config const &);
+
+			nano::bootstrap_ascending::account_sets sets;
+			mutable nano::mutex mutex;
+		};
+
+		static std::size_t constexpr accounts_shard_count = 16;
+		/** Inspection falls behind the block processor when above this many batches, the block processor then waits until there is room */
+		static std::size_t constexpr max_inspect_queue = 64;
+
+		accounts_shard & shard_for (nano::account const &);
+		/** Each shard is sized to hold its share of the configured set limits */
+		static nano::account_sets_config shard_config (nano::account_sets_config const &);
+
+		std::vector<std::unique_ptr<accounts_shard>> accounts;
+		/** Spreads requesting threads over different shards */
+		std::atomic<std::size_t> next_shard{ 0 };
 		nano::bootstrap_ascending::buffered_iterator iterator;
 		nano::bootstrap_ascending::throttle throttle;
 		// Calculates a lookback size based on the size of the ledger where larger ledgers have a larger sample count
@@ -158,11 +183,19 @@ namespace bootstrap_ascending
 		// A separate (lower) limiter ensures that we always reserve resources for querying accounts from priority queue
 		nano::bandwidth_limiter database_limiter;
 
-		bool stopped{ false };
+		// Blocks processed by the block processor, queued so that inspection does not hold up the block processor thread
+		std::deque<std::deque<std::pair<nano::process_return, std::shared_ptr<nano::block>>>> inspect_queue;
+		nano::mutex inspect_mutex;
+		nano::condition_variable inspect_condition;
+		/** Set once the inspection thread runs, batches are inspected on the calling thread before that */
+		std::atomic<bool> inspecting{ false };
+
+		std::atomic<bool> stopped{ false };
 		mutable nano::mutex mutex;
 		mutable nano::condition_variable condition;
-		std::thread thread;
+		std::vector<std::thread> threads;
 		std::thread timeout_thread;
+		std::thread inspect_thread;
 	};
 }
 }
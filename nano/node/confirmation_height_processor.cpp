@@ -1,14 +1,17 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/thread_roles.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/confirmation_height_processor.hpp>
 #include <nano/node/write_database_queue.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/ledger.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/confirmation_height.hpp>
 
 #include <boost/thread/latch.hpp>
 
-nano::confirmation_height_processor::confirmation_height_processor (nano::ledger & ledger_a, nano::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, nano::logger & logger_a, boost::latch & latch, confirmation_height_mode mode_a) :
+nano::confirmation_height_processor::confirmation_height_processor (nano::ledger & ledger_a, nano::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, nano::logger & logger_a, boost::latch & latch, confirmation_height_mode mode_a, unsigned discovery_threads_a) :
 	ledger (ledger_a),
 	write_database_queue (write_database_queue_a),
 	unbounded_processor (
@@ -28,6 +31,14 @@ nano::confirmation_height_processor::confirmation_height_processor (nano::ledger
 		this->run (mode_a);
 	})
 {
+	for (auto i = 0u; i < discovery_threads_a; ++i)
+	{
+		discovery_threads.emplace_back ([this, &latch] () {
+			nano::thread_role::set (nano::thread_role::name::confirmation_height_discovery);
+			latch.wait ();
+			run_discovery ();
+		});
+	}
 }
 
 nano::confirmation_height_processor::~confirmation_height_processor ()
@@ -42,6 +53,15 @@ void nano::confirmation_height_processor::stop ()
 		stopped = true;
 	}
 	condition.notify_one ();
+	{
+		nano::lock_guard<nano::mutex> guard (discovery_mutex);
+		discovery_queue.clear ();
+	}
+	discovery_condition.notify_all ();
+	for (auto & discovery_thread : discovery_threads)
+	{
+		nano::join_or_pass (discovery_thread);
+	}
 	if (thread.joinable ())
 	{
 		thread.join ();
@@ -156,11 +176,118 @@ void nano::confirmation_height_processor::unpause ()
 
 void nano::confirmation_height_processor::add (std::shared_ptr<nano::block> const & block_a)
 {
+	bool backlog;
 	{
 		nano::lock_guard<nano::mutex> lk (mutex);
 		awaiting_processing.get<tag_sequence> ().emplace_back (block_a);
+		// The first block is picked up by the cementing thread straight away, discovery only helps the ones queued behind it
+		backlog = awaiting_processing.size () > 1;
 	}
 	condition.notify_one ();
+	if (backlog && !discovery_threads.empty ())
+	{
+		{
+			nano::lock_guard<nano::mutex> guard (discovery_mutex);
+			if (discovery_queue.size () >= max_discovery_queue || stopped)
+			{
+				return;
+			}
+			discovery_queue.push_back (block_a);
+		}
+		discovery_condition.notify_one ();
+	}
+}
+
+void nano::confirmation_height_processor::run_discovery ()
+{
+	nano::unique_lock<nano::mutex> lock (discovery_mutex);
+	while (!stopped)
+	{
+		if (!discovery_queue.empty ())
+		{
+			auto block = std::move (discovery_queue.front ());
+			discovery_queue.pop_front ();
+			lock.unlock ();
+			discover (block);
+			lock.lock ();
+		}
+		else
+		{
+			discovery_condition.wait (lock);
+		}
+	}
+}
+
+void nano::confirmation_height_processor::discover (std::shared_ptr<nano::block> const & block_a)
+{
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		// Already taken by the cementing thread, walking it now would only compete for the same reads
+		if (awaiting_processing.get<tag_hash> ().count (block_a->hash ()) == 0)
+		{
+			return;
+		}
+	}
+	// Reading more than the cache holds would evict the blocks the cementing thread is about to read
+	auto const max_blocks = std::min (max_discovery_blocks, ledger.store.block.cache.max_blocks () / discovery_cache_share);
+	auto transaction (ledger.store.tx_begin_read ());
+	std::vector<nano::block_hash> hashes{ block_a->hash () };
+	std::size_t count = 0;
+	while (!hashes.empty () && count < max_blocks && !stopped)
+	{
+		auto block = ledger.store.block.get (transaction, hashes.back ());
+		hashes.pop_back ();
+		if (block == nullptr)
+		{
+			continue;
+		}
+		auto const account = ledger.account (*block);
+		auto const walked = walked_height (transaction, account);
+		auto const height = block->sideband ().height;
+		// Walk down the account chain until reaching blocks which are confirmed or were read earlier, possibly by another call
+		while (block != nullptr && block->sideband ().height > walked && count < max_blocks)
+		{
+			++count;
+			auto source (block->source ());
+			if (source.is_zero ())
+			{
+				source = block->link ().as_block_hash ();
+			}
+			// The link of a send is the destination account, not a dependency
+			if (!source.is_zero () && !ledger.is_epoch_link (source) && !block->sideband ().details.is_send)
+			{
+				hashes.push_back (source);
+			}
+			auto const previous = block->previous ();
+			block = previous.is_zero () ? nullptr : ledger.store.block.get (transaction, previous);
+		}
+		if (height > walked)
+		{
+			nano::lock_guard<nano::mutex> guard (discovery_mutex);
+			if (discovery_walked.size () >= max_discovery_walked && discovery_walked.count (account) == 0)
+			{
+				// Entries are pruned as blocks are cemented, this only triggers when chains were walked but never cemented
+				discovery_walked.clear ();
+			}
+			auto & walked_l = discovery_walked[account];
+			walked_l = std::max (walked_l, height);
+		}
+	}
+	discovered += count;
+}
+
+uint64_t nano::confirmation_height_processor::walked_height (store::transaction const & transaction_a, nano::account const & account_a)
+{
+	{
+		nano::lock_guard<nano::mutex> guard (discovery_mutex);
+		if (auto existing = discovery_walked.find (account_a); existing != discovery_walked.end ())
+		{
+			return existing->second;
+		}
+	}
+	nano::confirmation_height_info confirmation_height_info;
+	ledger.store.confirmation_height.get (transaction_a, account_a, confirmation_height_info);
+	return confirmation_height_info.height;
 }
 
 void nano::confirmation_height_processor::set_next_hash ()
@@ -186,6 +313,19 @@ void nano::confirmation_height_processor::add_block_already_cemented_observer (s
 
 void nano::confirmation_height_processor::notify_cemented (std::vector<std::shared_ptr<nano::block>> const & cemented_blocks)
 {
+	if (!discovery_threads.empty ())
+	{
+		// Chains cemented up to the walked height no longer need remembering, the confirmation height covers them
+		nano::lock_guard<nano::mutex> guard (discovery_mutex);
+		for (auto const & block : cemented_blocks)
+		{
+			auto existing = discovery_walked.find (ledger.account (*block));
+			if (existing != discovery_walked.end () && existing->second <= block->sideband ().height)
+			{
+				discovery_walked.erase (existing);
+			}
+		}
+	}
 	for (auto const & block_callback_data : cemented_blocks)
 	{
 		for (auto const & observer : cemented_observers)
@@ -212,6 +352,11 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (co
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "cemented_observers", cemented_observers_count, sizeof (decltype (confirmation_height_processor_a.cemented_observers)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "block_already_cemented_observers", block_already_cemented_observers_count, sizeof (decltype (confirmation_height_processor_a.block_already_cemented_observers)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "awaiting_processing", confirmation_height_processor_a.awaiting_processing_size (), sizeof (decltype (confirmation_height_processor_a.awaiting_processing)::value_type) }));
+	{
+		nano::lock_guard<nano::mutex> guard (confirmation_height_processor_a.discovery_mutex);
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "discovery_queue", confirmation_height_processor_a.discovery_queue.size (), sizeof (decltype (confirmation_height_processor_a.discovery_queue)::value_type) }));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ "discovery_walked", confirmation_height_processor_a.discovery_walked.size (), sizeof (decltype (confirmation_height_processor_a.discovery_walked)::value_type) }));
+	}
 	composite->add_component (collect_container_info (confirmation_height_processor_a.bounded_processor, "bounded_processor"));
 	composite->add_component (collect_container_info (confirmation_height_processor_a.unbounded_processor, "unbounded_processor"));
 	return composite;
@@ -14,7 +14,9 @@
 #include <boost/multi_index_container.hpp>
 
 #include <condition_variable>
+#include <deque>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -27,10 +29,15 @@ namespace nano
 class ledger;
 class write_database_queue;
 
+/**
+ * Cements blocks on a single thread. Optionally, blocks waiting behind the one being cemented are handed to discovery threads,
+ * which walk their unconfirmed dependency chains ahead of time so the cementing thread finds them in the block cache.
+ * Each walk is bounded by a share of the block cache capacity.
+ */
 class confirmation_height_processor final
 {
 public:
-	confirmation_height_processor (nano::ledger &, nano::write_database_queue &, std::chrono::milliseconds, nano::logger &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic);
+	confirmation_height_processor (nano::ledger &, nano::write_database_queue &, std::chrono::milliseconds, nano::logger &, boost::latch & initialized_latch, confirmation_height_mode = confirmation_height_mode::automatic, unsigned discovery_threads = 0);
 	~confirmation_height_processor ();
 
 	void pause ();
@@ -104,7 +111,28 @@ private:
 	confirmation_height_bounded bounded_processor;
 	std::thread thread;
 
+	/** Queued blocks yet to be walked by discovery threads, dropped when full as discovery is only an optimization */
+	std::deque<std::shared_ptr<nano::block>> discovery_queue;
+	nano::mutex discovery_mutex;
+	nano::condition_variable discovery_condition;
+	std::vector<std::thread> discovery_threads;
+	std::atomic<uint64_t> discovered{ 0 };
+	/** Height up to which each account chain has been read by discovery, shared between calls and pruned as blocks are cemented */
+	std::unordered_map<nano::account, uint64_t> discovery_walked;
+
+	static std::size_t constexpr max_discovery_queue = 16 * 1024;
+	/** Upper bound on blocks read for a single queued block, so one deep chain cannot evict everything else from the cache */
+	static std::size_t constexpr max_discovery_blocks = 64 * 1024;
+	/** A single walk reads at most this fraction of the block cache capacity, leaving room for the blocks the cementing thread is reading */
+	static std::size_t constexpr discovery_cache_share = 4;
+	static std::size_t constexpr max_discovery_walked = 64 * 1024;
+
 	void set_next_hash ();
+	void run_discovery ();
+	/** Reads the unconfirmed blocks \p block_a depends on, across all accounts, without modifying anything */
+	void discover (std::shared_ptr<nano::block> const & block_a);
+	/** Height up to which the chain of \p account_a was walked, or its confirmation height */
+	uint64_t walked_height (store::transaction const &, nano::account const & account_a);
 	void notify_cemented (std::vector<std::shared_ptr<nano::block>> const &);
 	void notify_already_cemented (nano::block_hash const &);
 
@@ -118,6 +146,8 @@ private: // Tests
 	friend class confirmation_height_many_accounts_many_confirmations_Test;
 	friend class confirmation_height_long_chains_Test;
 	friend class confirmation_height_many_accounts_single_confirmation_Test;
+	friend class confirmation_height_discovery_Test;
+	friend class confirmation_height_discovery_shared_walk_Test;
 	friend class request_aggregator_cannot_vote_Test;
 	friend class active_transactions_pessimistic_elections_Test;
 };
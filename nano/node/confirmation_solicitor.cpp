@@ -32,6 +32,7 @@ bool nano::confirmation_solicitor::broadcast (nano::election const & election_a)
 	{
 		auto const & hash (election_a.status.winner->hash ());
 		nano::publish winner{ config.network_params.network, election_a.status.winner };
+		auto buffer = winner.to_shared_const_buffer ();
 		unsigned count = 0;
 		// Directed broadcasting to principal representatives
 		for (auto i (representatives_broadcasts.begin ()), n (representatives_broadcasts.end ()); i != n && count < max_election_broadcasts; ++i)
@@ -41,7 +42,7 @@ bool nano::confirmation_solicitor::broadcast (nano::election const & election_a)
 			bool const different (exists && existing->second.hash != hash);
 			if (!exists || different)
 			{
-				i->channel->send (winner);
+				i->channel->send (winner, buffer);
 				count += different ? 0 : 1;
 			}
 		}
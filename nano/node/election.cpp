@@ -34,7 +34,8 @@ nano::election::election (nano::node & node_a, std::shared_ptr<nano::block> cons
 	root (block_a->root ()),
 	qualified_root (block_a->qualified_root ())
 {
-	last_votes.emplace (nano::account::null (), nano::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
+	auto const generation = node.ledger.weights_generation ();
+	set_vote_locked (nano::account::null (), nano::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () }, node.ledger.weight (nano::account::null ()), generation);
 	last_blocks.emplace (block_a->hash (), block_a);
 }
 
@@ -234,13 +235,16 @@ void nano::election::broadcast_vote ()
 nano::vote_info nano::election::get_last_vote (nano::account const & account)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	return last_votes[account];
+	auto existing = last_votes.find (account);
+	return existing != last_votes.end () ? existing->second : nano::vote_info{};
 }
 
 void nano::election::set_last_vote (nano::account const & account, nano::vote_info vote_info)
 {
+	auto const generation = node.ledger.weights_generation ();
+	auto weight = node.ledger.weight (account);
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	last_votes[account] = vote_info;
+	set_vote_locked (account, vote_info, weight, generation);
 }
 
 nano::election_status nano::election::get_status () const
@@ -252,6 +256,10 @@ nano::election_status nano::election::get_status () const
 bool nano::election::transition_time (nano::confirmation_solicitor & solicitor_a)
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
+	if (!confirmed_locked ())
+	{
+		refresh_tally ();
+	}
 	bool result = false;
 	switch (state_m)
 	{
@@ -343,38 +351,103 @@ nano::tally_t nano::election::tally () const
 
 nano::tally_t nano::election::tally_impl () const
 {
-	std::unordered_map<nano::block_hash, nano::uint128_t> block_weights;
-	std::unordered_map<nano::block_hash, nano::uint128_t> final_weights_l;
-	for (auto const & [account, info] : last_votes)
+	// Only blocks in the election are tallied and there are at most `max_blocks` of them, so ordering them here is cheap
+	nano::tally_t result;
+	for (auto const & [hash, block] : last_blocks)
 	{
-		auto rep_weight (node.ledger.weight (account));
-		block_weights[info.hash] += rep_weight;
-		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
+		auto existing = tallies.find (hash);
+		if (existing != tallies.end ())
 		{
-			final_weights_l[info.hash] += rep_weight;
+			result.emplace (existing->second.weight, block);
 		}
 	}
-	last_tally = block_weights;
-	nano::tally_t result;
-	for (auto const & [hash, amount] : block_weights)
+	// Final votes sum for winner
+	if (!result.empty ())
 	{
-		auto block (last_blocks.find (hash));
-		if (block != last_blocks.end ())
+		auto existing = tallies.find (result.begin ()->second->hash ());
+		if (existing != tallies.end () && existing->second.final_weight > 0)
 		{
-			result.emplace (amount, block->second);
+			final_weight = existing->second.final_weight;
 		}
 	}
-	// Calculate final votes sum for winner
-	if (!final_weights_l.empty () && !result.empty ())
+	return result;
+}
+
+void nano::election::set_vote_locked (nano::account const & representative, nano::vote_info const & info, nano::uint128_t const & weight, uint64_t generation)
+{
+	if (generation != tally_generation)
+	{
+		// The weight may predate the last refresh, refresh again on the next pass
+		tally_generation = std::numeric_limits<uint64_t>::max ();
+	}
+	auto [existing, inserted] = last_votes.emplace (representative, info);
+	auto & counted = vote_weights[representative];
+	if (!inserted)
+	{
+		tally_subtract (existing->second, counted);
+		existing->second = info;
+	}
+	counted = weight;
+	tally_add (info, weight);
+}
+
+auto nano::election::erase_vote_locked (std::unordered_map<nano::account, nano::vote_info>::iterator existing) -> std::unordered_map<nano::account, nano::vote_info>::iterator
+{
+	auto counted = vote_weights.find (existing->first);
+	debug_assert (counted != vote_weights.end ());
+	tally_subtract (existing->second, counted->second);
+	vote_weights.erase (counted);
+	return last_votes.erase (existing);
+}
+
+void nano::election::tally_add (nano::vote_info const & info, nano::uint128_t const & weight)
+{
+	auto & entry = tallies[info.hash];
+	entry.weight += weight;
+	if (nano::vote::is_final_timestamp (info.timestamp))
+	{
+		entry.final_weight += weight;
+	}
+	++entry.votes;
+}
+
+void nano::election::tally_subtract (nano::vote_info const & info, nano::uint128_t const & weight)
+{
+	auto existing = tallies.find (info.hash);
+	debug_assert (existing != tallies.end ());
+	auto & entry = existing->second;
+	debug_assert (entry.weight >= weight && entry.votes > 0);
+	entry.weight -= weight;
+	if (nano::vote::is_final_timestamp (info.timestamp))
+	{
+		entry.final_weight -= weight;
+	}
+	if (--entry.votes == 0)
+	{
+		tallies.erase (existing);
+	}
+}
+
+void nano::election::refresh_tally ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto const generation = node.ledger.weights_generation ();
+	if (generation == tally_generation)
+	{
+		return;
+	}
+	tally_generation = generation;
+	for (auto const & [account, info] : last_votes)
 	{
-		auto winner_hash (result.begin ()->second->hash ());
-		auto find_final (final_weights_l.find (winner_hash));
-		if (find_final != final_weights_l.end ())
+		auto & counted = vote_weights[account];
+		auto const weight = node.ledger.weight (account);
+		if (weight != counted)
 		{
-			final_weight = find_final->second;
+			tally_subtract (info, counted);
+			tally_add (info, weight);
+			counted = weight;
 		}
 	}
-	return result;
 }
 
 void nano::election::confirm_if_quorum (nano::unique_lock<nano::mutex> & lock_a)
@@ -460,6 +533,7 @@ std::shared_ptr<nano::block> nano::election::find (nano::block_hash const & hash
 
 nano::election_vote_result nano::election::vote (nano::account const & rep, uint64_t timestamp_a, nano::block_hash const & block_hash_a, vote_source vote_source_a)
 {
+	auto const generation = node.ledger.weights_generation ();
 	auto weight = node.ledger.weight (rep);
 	if (!node.network_params.network.is_dev_network () && weight <= node.minimum_principal_weight ())
 	{
@@ -496,7 +570,7 @@ nano::election_vote_result nano::election::vote (nano::account const & rep, uint
 		}
 	}
 
-	last_votes[rep] = { std::chrono::steady_clock::now (), timestamp_a, block_hash_a };
+	set_vote_locked (rep, { std::chrono::steady_clock::now (), timestamp_a, block_hash_a }, weight, generation);
 	if (vote_source_a == vote_source::live)
 	{
 		live_vote_action (rep);
@@ -633,7 +707,10 @@ void nano::election::remove_votes (nano::block_hash const & hash_a)
 		auto list_generated_votes (node.history.votes (root, hash_a));
 		for (auto const & vote : list_generated_votes)
 		{
-			last_votes.erase (vote->account);
+			if (auto existing = last_votes.find (vote->account); existing != last_votes.end ())
+			{
+				erase_vote_locked (existing);
+			}
 		}
 		// Clear votes cache
 		node.history.erase (root);
@@ -651,7 +728,7 @@ void nano::election::remove_block (nano::block_hash const & hash_a)
 			{
 				if (i->second.hash == hash_a)
 				{
-					i = last_votes.erase (i);
+					i = erase_vote_locked (i);
 				}
 				else
 				{
@@ -671,8 +748,8 @@ bool nano::election::replace_by_weight (nano::unique_lock<nano::mutex> & lock_a,
 	auto winner_hash (status.winner->hash ());
 	// Sort existing blocks tally
 	std::vector<std::pair<nano::block_hash, nano::uint128_t>> sorted;
-	sorted.reserve (last_tally.size ());
-	std::copy (last_tally.begin (), last_tally.end (), std::back_inserter (sorted));
+	sorted.reserve (tallies.size ());
+	std::transform (tallies.begin (), tallies.end (), std::back_inserter (sorted), [] (auto const & entry) { return std::make_pair (entry.first, entry.second.weight); });
 	lock_a.unlock ();
 	// Sort in ascending order
 	std::sort (sorted.begin (), sorted.end (), [] (auto const & left, auto const & right) { return left.second < right.second; });
@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <limits>
 #include <memory>
 
 namespace nano
@@ -187,6 +188,13 @@ private:
 	void broadcast_vote_locked (nano::unique_lock<nano::mutex> & lock);
 	void remove_votes (nano::block_hash const &);
 	void remove_block (nano::block_hash const &);
+	/** Records the vote of \p representative counted with \p weight read at weights \p generation, replacing its previous vote in the tallies */
+	void set_vote_locked (nano::account const & representative, nano::vote_info const &, nano::uint128_t const & weight, uint64_t generation);
+	std::unordered_map<nano::account, nano::vote_info>::iterator erase_vote_locked (std::unordered_map<nano::account, nano::vote_info>::iterator);
+	void tally_add (nano::vote_info const &, nano::uint128_t const & weight);
+	void tally_subtract (nano::vote_info const &, nano::uint128_t const & weight);
+	/** Applies changes in representative weights since the votes were counted, only rereading weights when the ledger weights generation changed */
+	void refresh_tally ();
 	bool replace_by_weight (nano::unique_lock<nano::mutex> & lock_a, nano::block_hash const &);
 	std::chrono::milliseconds time_to_live () const;
 	/**
@@ -203,7 +211,20 @@ private:
 	std::unordered_map<nano::account, nano::vote_info> last_votes;
 	std::atomic<bool> is_quorum{ false };
 	mutable nano::uint128_t final_weight{ 0 };
-	mutable std::unordered_map<nano::block_hash, nano::uint128_t> last_tally;
+
+	class block_tally final
+	{
+	public:
+		nano::uint128_t weight{ 0 };
+		nano::uint128_t final_weight{ 0 };
+		std::size_t votes{ 0 };
+	};
+	// Vote weight per block, kept up to date as votes arrive instead of being summed over all voters on each vote
+	std::unordered_map<nano::block_hash, block_tally> tallies;
+	// Weight each representative's current vote was counted with
+	std::unordered_map<nano::account, nano::uint128_t> vote_weights;
+	// Ledger weights generation the tallies were last refreshed at
+	uint64_t tally_generation{ std::numeric_limits<uint64_t>::max () };
 
 	nano::election_behavior const behavior_m{ nano::election_behavior::normal };
 	std::chrono::steady_clock::time_point const election_start = { std::chrono::steady_clock::now () };
@@ -9,6 +9,7 @@
 #include <nano/node/node.hpp>
 #include <nano/node/node_rpc_config.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/store/delegator.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -158,7 +159,7 @@ void nano::json_handler::process_request (bool unsafe_a)
 
 void nano::json_handler::response_errors ()
 {
-	if (!ec && response_l.empty ())
+	if (!ec && response_l.empty () && !response_writer)
 	{
 		// Return an error code if no response data was given
 		ec = nano::error_rpc::empty_response;
@@ -171,6 +172,11 @@ void nano::json_handler::response_errors ()
 		boost::property_tree::write_json (ostream, response_error);
 		response (ostream.str ());
 	}
+	else if (response_writer)
+	{
+		response_writer->end_object ();
+		response (response_writer->release ());
+	}
 	else
 	{
 		std::stringstream ostream;
@@ -179,6 +185,23 @@ void nano::json_handler::response_errors ()
 	}
 }
 
+nano::json_writer & nano::json_handler::response_stream ()
+{
+	if (!response_writer)
+	{
+		response_writer.emplace ();
+		response_writer->begin_object ();
+		// Fields such as "deprecated" are put by the action forwarding to this one
+		for (auto const & [key, child] : response_l)
+		{
+			debug_assert (child.empty ());
+			response_writer->put (key, child.data ());
+		}
+		response_l.clear ();
+	}
+	return *response_writer;
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -2218,22 +2241,21 @@ void nano::json_handler::delegators ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		boost::property_tree::ptree delegators;
-		for (auto i (node.store.account.begin (transaction, start_account.number () + 1)), n (node.store.account.end ()); i != n && delegators.size () < count; ++i)
+		auto & writer (response_stream ());
+		writer.begin_object ("delegators");
+		for (auto i (node.store.delegator.begin (transaction, nano::delegator_key (representative, start_account.number () + 1))), n (node.store.delegator.end ()); i != n && i->first.representative == representative && writer.count () < count; ++i)
 		{
-			nano::account_info const & info (i->second);
-			if (info.representative == representative)
+			nano::account const & delegator (i->first.account);
+			auto info (node.store.account.get (transaction, delegator));
+			debug_assert (info);
+			if (info && info->balance.number () >= threshold.number ())
 			{
-				if (info.balance.number () >= threshold.number ())
-				{
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					nano::account const & delegator (i->first);
-					delegators.put (delegator.to_account (), balance);
-				}
+				std::string balance;
+				nano::uint128_union (info->balance).encode_dec (balance);
+				writer.put (delegator.to_account (), balance);
 			}
 		}
-		response_l.add_child ("delegators", delegators);
+		writer.end_object ();
 	}
 	response_errors ();
 }
@@ -2245,13 +2267,9 @@ void nano::json_handler::delegators_count ()
 	{
 		uint64_t count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.account.begin (transaction)), n (node.store.account.end ()); i != n; ++i)
+		for (auto i (node.store.delegator.begin (transaction, nano::delegator_key (account, 0))), n (node.store.delegator.end ()); i != n && i->first.representative == account; ++i)
 		{
-			nano::account_info const & info (i->second);
-			if (info.representative == account)
-			{
-				++count;
-			}
+			++count;
 		}
 		response_l.put ("count", std::to_string (count));
 	}
@@ -2756,45 +2774,52 @@ void nano::json_handler::ledger ()
 		bool const weight = request.get<bool> ("weight", false);
 		bool const pending = request.get<bool> ("pending", false);
 		bool const receivable = request.get<bool> ("receivable", pending);
-		boost::property_tree::ptree accounts;
 		auto transaction (node.store.tx_begin_read ());
+		auto & writer (response_stream ());
+		writer.begin_object ("accounts");
+		auto write_account = [&] (nano::account const & account, nano::account_info const & info) {
+			if (receivable)
+			{
+				auto account_receivable = node.ledger.account_receivable (transaction, account);
+				if (info.balance.number () + account_receivable < threshold.number ())
+				{
+					return;
+				}
+				writer.begin_object (account.to_account ());
+				writer.put ("pending", account_receivable.convert_to<std::string> ());
+				writer.put ("receivable", account_receivable.convert_to<std::string> ());
+			}
+			else
+			{
+				writer.begin_object (account.to_account ());
+			}
+			writer.put ("frontier", info.head.to_string ());
+			writer.put ("open_block", info.open_block.to_string ());
+			writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+			std::string balance;
+			nano::uint128_union (info.balance).encode_dec (balance);
+			writer.put ("balance", balance);
+			writer.put ("modified_timestamp", std::to_string (info.modified));
+			writer.put ("block_count", std::to_string (info.block_count));
+			if (representative)
+			{
+				writer.put ("representative", info.representative.to_account ());
+			}
+			if (weight)
+			{
+				auto account_weight (node.ledger.weight (account));
+				writer.put ("weight", account_weight.convert_to<std::string> ());
+			}
+			writer.end_object ();
+		};
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && writer.count () < count; ++i)
 			{
 				nano::account_info const & info (i->second);
 				if (info.modified >= modified_since && (receivable || info.balance.number () >= threshold.number ()))
 				{
-					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
-					if (receivable)
-					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
-						if (info.balance.number () + account_receivable < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						response_a.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					write_account (i->first, info);
 				}
 			}
 		}
@@ -2813,45 +2838,16 @@ void nano::json_handler::ledger ()
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && writer.count () < count; ++i)
 			{
 				node.store.account.get (transaction, i->second, info);
 				if (receivable || info.balance.number () >= threshold.number ())
 				{
-					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
-					if (receivable)
-					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
-						if (info.balance.number () + account_receivable < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						response_a.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					write_account (i->second, info);
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		writer.end_object ();
 	}
 	response_errors ();
 }
@@ -3058,12 +3054,39 @@ void nano::json_handler::receivable ()
 	if (!ec)
 	{
 		auto offset_counter = offset;
-		boost::property_tree::ptree peers_l;
 		auto transaction (node.store.tx_begin_read ());
-		// The ptree container is used if there are any children nodes (e.g source/min_version) otherwise the amount container is used.
-		std::vector<std::pair<std::string, boost::property_tree::ptree>> hash_ptree_pairs;
-		std::vector<std::pair<std::string, nano::uint128_t>> hash_amount_pairs;
-		for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
+		auto & writer (response_stream ());
+		if (simple)
+		{
+			writer.begin_array ("blocks");
+		}
+		else
+		{
+			writer.begin_object ("blocks");
+		}
+		// Entries are written as an object when there are any children (e.g source/min_version) otherwise as the amount
+		auto write_entry = [&] (nano::block_hash const & hash, nano::pending_info const & info) {
+			if (source || min_version)
+			{
+				writer.begin_object (hash.to_string ());
+				writer.put ("amount", info.amount.number ().convert_to<std::string> ());
+				if (source)
+				{
+					writer.put ("source", info.source.to_account ());
+				}
+				if (min_version)
+				{
+					writer.put ("min_version", epoch_as_string (info.epoch));
+				}
+				writer.end_object ();
+			}
+			else
+			{
+				writer.put (hash.to_string (), info.amount.number ().convert_to<std::string> ());
+			}
+		};
+		std::vector<std::pair<nano::block_hash, nano::pending_info>> sorted;
+		for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && (should_sort || writer.count () < count); ++i)
 		{
 			nano::pending_key const & key (i->first);
 			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
@@ -3076,47 +3099,20 @@ void nano::json_handler::receivable ()
 
 				if (simple)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", key.hash.to_string ());
-					peers_l.push_back (std::make_pair ("", entry));
+					writer.put (key.hash.to_string ());
 				}
 				else
 				{
 					nano::pending_info const & info (i->second);
 					if (info.amount.number () >= threshold.number ())
 					{
-						if (source || min_version)
+						if (should_sort)
 						{
-							boost::property_tree::ptree pending_tree;
-							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-							if (source)
-							{
-								pending_tree.put ("source", info.source.to_account ());
-							}
-							if (min_version)
-							{
-								pending_tree.put ("min_version", epoch_as_string (info.epoch));
-							}
-
-							if (should_sort)
-							{
-								hash_ptree_pairs.emplace_back (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
+							sorted.emplace_back (key.hash, info);
 						}
 						else
 						{
-							if (should_sort)
-							{
-								hash_amount_pairs.emplace_back (key.hash.to_string (), info.amount.number ());
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							write_entry (key.hash, info);
 						}
 					}
 				}
@@ -3124,29 +3120,22 @@ void nano::json_handler::receivable ()
 		}
 		if (should_sort)
 		{
-			if (source || min_version)
-			{
-				std::stable_sort (hash_ptree_pairs.begin (), hash_ptree_pairs.end (), [] (auto const & lhs, auto const & rhs) {
-					return lhs.second.template get<nano::uint128_t> ("amount") > rhs.second.template get<nano::uint128_t> ("amount");
-				});
-				for (auto i = offset, j = offset + count; i < hash_ptree_pairs.size () && i < j; ++i)
-				{
-					peers_l.add_child (hash_ptree_pairs[i].first, hash_ptree_pairs[i].second);
-				}
-			}
-			else
+			std::stable_sort (sorted.begin (), sorted.end (), [] (auto const & lhs, auto const & rhs) {
+				return lhs.second.amount.number () > rhs.second.amount.number ();
+			});
+			for (auto i = offset, j = offset + count; i < sorted.size () && i < j; ++i)
 			{
-				std::stable_sort (hash_amount_pairs.begin (), hash_amount_pairs.end (), [] (auto const & lhs, auto const & rhs) {
-					return lhs.second > rhs.second;
-				});
-
-				for (auto i = offset, j = offset + count; i < hash_amount_pairs.size () && i < j; ++i)
-				{
-					peers_l.put (hash_amount_pairs[i].first, hash_amount_pairs[i].second.convert_to<std::string> ());
-				}
+				write_entry (sorted[i].first, sorted[i].second);
 			}
 		}
-		response_l.add_child ("blocks", peers_l);
+		if (simple)
+		{
+			writer.end_array ();
+		}
+		else
+		{
+			writer.end_object ();
+		}
 	}
 	response_errors ();
 }
@@ -3514,7 +3503,8 @@ void nano::json_handler::representatives ()
 	{
 		bool const sorting = request.get<bool> ("sorting", false);
 		boost::property_tree::ptree representatives;
-		auto rep_amounts = node.ledger.cache.rep_weights.get_rep_amounts ();
+		auto const rep_amounts_snapshot = node.ledger.cache.rep_weights.get_rep_amounts ();
+		auto const & rep_amounts = *rep_amounts_snapshot;
 		if (!sorting) // Simple
 		{
 			std::map<nano::account, nano::uint128_t> ordered (rep_amounts.begin (), rep_amounts.end ());
@@ -4261,8 +4251,9 @@ void nano::json_handler::unopened ()
 		auto end (node.store.pending.end ());
 		nano::account current_account (start);
 		nano::uint128_t current_account_sum{ 0 };
-		boost::property_tree::ptree accounts;
-		while (iterator != end && accounts.size () < count)
+		auto & writer (response_stream ());
+		writer.begin_object ("accounts");
+		while (iterator != end && writer.count () < count)
 		{
 			nano::pending_key key (iterator->first);
 			nano::account account (key.account);
@@ -4284,7 +4275,7 @@ void nano::json_handler::unopened ()
 					{
 						if (current_account_sum >= threshold.number ())
 						{
-							accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+							writer.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
 						}
 						current_account_sum = 0;
 					}
@@ -4295,11 +4286,11 @@ void nano::json_handler::unopened ()
 			}
 		}
 		// last one after iterator reaches end
-		if (accounts.size () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
+		if (writer.count () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
 		{
-			accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+			writer.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
 		}
-		response_l.add_child ("accounts", accounts);
+		writer.end_object ();
 	}
 	response_errors ();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/node/ipc/flatbuffers_handler.hpp>
 #include <nano/node/wallet.hpp>
@@ -8,6 +9,7 @@
 #include <boost/property_tree/ptree.hpp>
 
 #include <functional>
+#include <optional>
 #include <string>
 
 namespace nano
@@ -154,6 +156,10 @@ public:
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
+	/** Streamed response written as text instead of response_l, used by actions with potentially large results */
+	std::optional<nano::json_writer> response_writer;
+	/** Starts the streamed response, fields already put in response_l are written first */
+	nano::json_writer & response_stream ();
 	std::shared_ptr<nano::wallet> wallet_impl ();
 	bool wallet_locked_impl (store::transaction const &, std::shared_ptr<nano::wallet> const &);
 	bool wallet_account_impl (store::transaction const &, std::shared_ptr<nano::wallet> const &, nano::account const &);
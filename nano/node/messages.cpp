@@ -1851,7 +1851,13 @@ void nano::asc_pull_ack::operator() (nano::object_stream & obs) const
 void nano::asc_pull_ack::blocks_payload::serialize (nano::stream & stream) const
 {
 	debug_assert (blocks.size () <= max_blocks);
+	debug_assert (serialized_count <= max_blocks);
+	debug_assert (blocks.empty () || serialized_blocks.empty ());
 
+	if (!serialized_blocks.empty ())
+	{
+		nano::write (stream, serialized_blocks);
+	}
 	for (auto & block : blocks)
 	{
 		debug_assert (block != nullptr);
@@ -1871,9 +1877,15 @@ void nano::asc_pull_ack::blocks_payload::deserialize (nano::stream & stream)
 	}
 }
 
+std::size_t nano::asc_pull_ack::blocks_payload::size () const
+{
+	return blocks.size () + serialized_count;
+}
+
 void nano::asc_pull_ack::blocks_payload::operator() (nano::object_stream & obs) const
 {
 	obs.write_range ("blocks", blocks);
+	obs.write ("serialized_count", serialized_count);
 }
 
 /*
@@ -613,8 +613,18 @@ public: // Payload definitions
 		void serialize (nano::stream &) const;
 		void deserialize (nano::stream &);
 
+		/** Number of blocks in the payload, decoded or serialized */
+		std::size_t size () const;
+
 	public: // Payload
 		std::vector<std::shared_ptr<nano::block>> blocks;
+		/**
+		 * Blocks already in network serialization, sent in place of `blocks` when not empty.
+		 * Lets the bootstrap server pass blocks read from the ledger through without decoding them. Never filled in by `deserialize`.
+		 */
+		std::vector<uint8_t> serialized_blocks;
+		/** Number of blocks contained in `serialized_blocks` */
+		std::size_t serialized_count{ 0 };
 
 	public: // Logging
 		void operator() (nano::object_stream &) const;
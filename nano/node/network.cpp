@@ -21,9 +21,9 @@ nano::network::network (nano::node & node_a, uint16_t port_a) :
 		process_message (message, channel);
 	} },
 	resolver (node_a.io_ctx),
-	tcp_message_manager (node_a.config.tcp_incoming_connections_max),
+	tcp_message_manager (node_a.stats),
 	node (node_a),
-	publish_filter (256 * 1024),
+	publish_filter (256 * 1024, node_a.stats),
 	tcp_channels (node_a, inbound),
 	port (port_a),
 	disconnect_observer ([] () {})
@@ -138,9 +138,11 @@ void nano::network::send_node_id_handshake (std::shared_ptr<nano::transport::cha
 
 void nano::network::flood_message (nano::message & message_a, nano::transport::buffer_drop_policy const drop_policy_a, float const scale_a)
 {
+	// Serialize once and share the buffer between all channels
+	auto buffer = message_a.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale_a)))
 	{
-		i->send (message_a, nullptr, drop_policy_a);
+		i->send (message_a, buffer, nullptr, drop_policy_a);
 	}
 }
 
@@ -167,31 +169,53 @@ void nano::network::flood_block (std::shared_ptr<nano::block> const & block_a, n
 void nano::network::flood_block_initial (std::shared_ptr<nano::block> const & block_a)
 {
 	nano::publish message (node.network_params.network, block_a);
+	auto buffer = message.to_shared_const_buffer ();
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 	for (auto & i : list_non_pr (fanout (1.0)))
 	{
-		i->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 }
 
 void nano::network::flood_vote (std::shared_ptr<nano::vote> const & vote_a, float scale)
 {
 	nano::confirm_ack message{ node.network_params.network, vote_a };
+	auto buffer = message.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale)))
 	{
-		i->send (message, nullptr);
+		i->send (message, buffer, nullptr);
 	}
 }
 
 void nano::network::flood_vote_pr (std::shared_ptr<nano::vote> const & vote_a)
 {
 	nano::confirm_ack message{ node.network_params.network, vote_a };
+	auto buffer = message.to_shared_const_buffer ();
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+	}
+}
+
+void nano::network::flood_votes (std::vector<std::shared_ptr<nano::vote>> const & votes_a, float scale)
+{
+	auto const representatives = node.rep_crawler.principal_representatives ();
+	auto const peers = list (fanout (scale));
+	for (auto const & vote : votes_a)
+	{
+		nano::confirm_ack message{ node.network_params.network, vote };
+		auto buffer = message.to_shared_const_buffer ();
+		for (auto const & i : representatives)
+		{
+			i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		}
+		for (auto const & i : peers)
+		{
+			i->send (message, buffer, nullptr);
+		}
 	}
 }
 
@@ -768,44 +792,88 @@ nano::node_id_handshake::response_payload nano::network::prepare_handshake_respo
  * tcp_message_manager
  */
 
-nano::tcp_message_manager::tcp_message_manager (unsigned incoming_connections_max_a) :
-	max_entries (incoming_connections_max_a * nano::tcp_message_manager::max_entries_per_connection + 1)
+nano::tcp_message_manager::tcp_message_manager (nano::stats & stats_a, std::size_t max_entries_per_peer_a) :
+	stats{ stats_a },
+	max_entries_per_peer{ max_entries_per_peer_a }
 {
-	debug_assert (max_entries > 0);
+	debug_assert (max_entries_per_peer > 0);
 }
 
-void nano::tcp_message_manager::put_message (nano::tcp_message_item const & item_a)
+bool nano::tcp_message_manager::put_message (nano::tcp_message_item const & item_a)
 {
+	auto const priority_l = priority_of (item_a);
+	auto const index = static_cast<std::size_t> (priority_l);
 	{
-		nano::unique_lock<nano::mutex> lock{ mutex };
-		while (entries.size () >= max_entries && !stopped)
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		if (stopped)
 		{
-			producer_condition.wait (lock);
+			return true;
 		}
-		entries.push_back (item_a);
+		auto & peer = peers[item_a.endpoint];
+		auto & queue = peer.queues[index];
+		if (queue.size () >= max_entries_per_peer)
+		{
+			stats.inc (nano::stat::type::tcp_message_manager, nano::stat::detail::overfill);
+			if (item_a.message)
+			{
+				stats.inc (nano::stat::type::drop, to_stat_detail (item_a.message->type ()), nano::stat::dir::in);
+			}
+			return true;
+		}
+		if (queue.empty ())
+		{
+			ready[index].push_back (item_a.endpoint);
+		}
+		queue.push_back (item_a);
+		++total;
 	}
-	consumer_condition.notify_one ();
+	condition.notify_one ();
+	return false;
 }
 
 nano::tcp_message_item nano::tcp_message_manager::get_message ()
 {
-	nano::tcp_message_item result;
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	while (entries.empty () && !stopped)
+	condition.wait (lock, [this] () { return stopped || total > 0; });
+	if (stopped)
 	{
-		consumer_condition.wait (lock);
+		return nano::tcp_message_item{ nullptr, nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0), 0, nullptr };
 	}
-	if (!entries.empty ())
+	auto const high = static_cast<std::size_t> (priority::high);
+	auto const normal = static_cast<std::size_t> (priority::normal);
+	// Serve high priority messages first, but let a normal one through regularly
+	if (!ready[high].empty () && (ready[normal].empty () || high_streak + 1 < high_priority_ratio))
 	{
-		result = std::move (entries.front ());
-		entries.pop_front ();
+		++high_streak;
+		return pop (priority::high);
 	}
-	else
-	{
-		result = nano::tcp_message_item{ nullptr, nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0), 0, nullptr };
+	high_streak = 0;
+	return pop (priority::normal);
+}
+
+nano::tcp_message_item nano::tcp_message_manager::pop (priority priority_a)
+{
+	debug_assert (!mutex.try_lock ());
+	auto const index = static_cast<std::size_t> (priority_a);
+	auto & ready_l = ready[index];
+	debug_assert (!ready_l.empty ());
+	auto endpoint = ready_l.front ();
+	ready_l.pop_front ();
+	auto existing = peers.find (endpoint);
+	debug_assert (existing != peers.end ());
+	auto & queue = existing->second.queues[index];
+	auto result = std::move (queue.front ());
+	queue.pop_front ();
+	--total;
+	if (!queue.empty ())
+	{
+		// Peer goes to the back of the round robin
+		ready_l.push_back (endpoint);
+	}
+	else if (existing->second.empty ())
+	{
+		peers.erase (existing);
 	}
-	lock.unlock ();
-	producer_condition.notify_one ();
 	return result;
 }
 
@@ -815,8 +883,56 @@ void nano::tcp_message_manager::stop ()
 		nano::lock_guard<nano::mutex> lock{ mutex };
 		stopped = true;
 	}
-	consumer_condition.notify_all ();
-	producer_condition.notify_all ();
+	condition.notify_all ();
+}
+
+std::size_t nano::tcp_message_manager::size () const
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	return total;
+}
+
+std::size_t nano::tcp_message_manager::size (nano::tcp_endpoint const & endpoint_a) const
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto existing = peers.find (endpoint_a);
+	return existing != peers.end () ? existing->second.size () : 0;
+}
+
+auto nano::tcp_message_manager::priority_of (nano::tcp_message_item const & item_a) -> priority
+{
+	if (item_a.message)
+	{
+		switch (item_a.message->type ())
+		{
+			case nano::message_type::confirm_ack:
+			case nano::message_type::confirm_req:
+			case nano::message_type::publish:
+				return priority::high;
+			default:
+				break;
+		}
+	}
+	return priority::normal;
+}
+
+std::unique_ptr<nano::container_info_component> nano::tcp_message_manager::collect_container_info (std::string const & name)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "messages", total, sizeof (nano::tcp_message_item) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", peers.size (), sizeof (decltype (peers)::value_type) }));
+	return composite;
+}
+
+bool nano::tcp_message_manager::peer_queue::empty () const
+{
+	return std::all_of (queues.begin (), queues.end (), [] (auto const & queue) { return queue.empty (); });
+}
+
+std::size_t nano::tcp_message_manager::peer_queue::size () const
+{
+	return queues[0].size () + queues[1].size ();
 }
 
 /*
@@ -828,21 +944,42 @@ nano::syn_cookies::syn_cookies (std::size_t max_cookies_per_ip_a) :
 {
 }
 
+auto nano::syn_cookies::shard_for (nano::endpoint const & endpoint_a) -> shard &
+{
+	return shards[std::hash<boost::asio::ip::address>{}(endpoint_a.address ()) % shard_count];
+}
+
+void nano::syn_cookies::shard::erase (std::unordered_map<nano::endpoint, syn_cookie_info>::iterator it)
+{
+	debug_assert (!mutex.try_lock ());
+	unsigned & ip_cookies = cookies_per_ip[it->first.address ()];
+	if (ip_cookies > 0)
+	{
+		--ip_cookies;
+	}
+	else
+	{
+		debug_assert (false && "More SYN cookies deleted than created for IP");
+	}
+	cookies.erase (it);
+}
+
 boost::optional<nano::uint256_union> nano::syn_cookies::assign (nano::endpoint const & endpoint_a)
 {
 	auto ip_addr (endpoint_a.address ());
 	debug_assert (ip_addr.is_v6 ());
-	nano::lock_guard<nano::mutex> lock{ syn_cookie_mutex };
-	unsigned & ip_cookies = cookies_per_ip[ip_addr];
+	auto & shard_l = shard_for (endpoint_a);
+	nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+	unsigned & ip_cookies = shard_l.cookies_per_ip[ip_addr];
 	boost::optional<nano::uint256_union> result;
 	if (ip_cookies < max_cookies_per_ip)
 	{
-		if (cookies.find (endpoint_a) == cookies.end ())
+		if (shard_l.cookies.find (endpoint_a) == shard_l.cookies.end ())
 		{
 			nano::uint256_union query;
 			random_pool::generate_block (query.bytes.data (), query.bytes.size ());
 			syn_cookie_info info{ query, std::chrono::steady_clock::now () };
-			cookies[endpoint_a] = info;
+			shard_l.cookies[endpoint_a] = info;
 			++ip_cookies;
 			result = query;
 		}
@@ -852,23 +989,28 @@ boost::optional<nano::uint256_union> nano::syn_cookies::assign (nano::endpoint c
 
 bool nano::syn_cookies::validate (nano::endpoint const & endpoint_a, nano::account const & node_id, nano::signature const & sig)
 {
-	auto ip_addr (endpoint_a.address ());
-	debug_assert (ip_addr.is_v6 ());
-	nano::lock_guard<nano::mutex> lock{ syn_cookie_mutex };
-	auto result (true);
-	auto cookie_it (cookies.find (endpoint_a));
-	if (cookie_it != cookies.end () && !nano::validate_message (node_id, cookie_it->second.cookie, sig))
+	debug_assert (endpoint_a.address ().is_v6 ());
+	auto & shard_l = shard_for (endpoint_a);
+	std::optional<nano::uint256_union> cookie_l;
 	{
-		result = false;
-		cookies.erase (cookie_it);
-		unsigned & ip_cookies = cookies_per_ip[ip_addr];
-		if (ip_cookies > 0)
+		nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+		auto cookie_it (shard_l.cookies.find (endpoint_a));
+		if (cookie_it != shard_l.cookies.end ())
 		{
-			--ip_cookies;
+			cookie_l = cookie_it->second.cookie;
 		}
-		else
+	}
+	// Signature is checked without holding the lock
+	auto result (true);
+	if (cookie_l && !nano::validate_message (node_id, *cookie_l, sig))
+	{
+		nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+		auto cookie_it (shard_l.cookies.find (endpoint_a));
+		// The cookie could have been consumed or replaced concurrently
+		if (cookie_it != shard_l.cookies.end () && cookie_it->second.cookie == *cookie_l)
 		{
-			debug_assert (false && "More SYN cookies deleted than created for IP");
+			result = false;
+			shard_l.erase (cookie_it);
 		}
 	}
 	return result;
@@ -876,50 +1018,30 @@ bool nano::syn_cookies::validate (nano::endpoint const & endpoint_a, nano::accou
 
 void nano::syn_cookies::purge (std::chrono::steady_clock::time_point const & cutoff_a)
 {
-	nano::lock_guard<nano::mutex> lock{ syn_cookie_mutex };
-	auto it (cookies.begin ());
-	while (it != cookies.end ())
+	for (auto & shard_l : shards)
 	{
-		auto info (it->second);
-		if (info.created_at < cutoff_a)
+		nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+		for (auto it (shard_l.cookies.begin ()); it != shard_l.cookies.end ();)
 		{
-			unsigned & per_ip = cookies_per_ip[it->first.address ()];
-			if (per_ip > 0)
-			{
-				--per_ip;
-			}
-			else
+			auto current (it++);
+			if (current->second.created_at < cutoff_a)
 			{
-				debug_assert (false && "More SYN cookies deleted than created for IP");
+				shard_l.erase (current);
 			}
-			it = cookies.erase (it);
-		}
-		else
-		{
-			++it;
 		}
 	}
 }
 
 std::optional<nano::uint256_union> nano::syn_cookies::cookie (const nano::endpoint & endpoint_a)
 {
-	auto ip_addr (endpoint_a.address ());
-	debug_assert (ip_addr.is_v6 ());
-	nano::lock_guard<nano::mutex> lock{ syn_cookie_mutex };
-	auto cookie_it (cookies.find (endpoint_a));
-	if (cookie_it != cookies.end ())
+	debug_assert (endpoint_a.address ().is_v6 ());
+	auto & shard_l = shard_for (endpoint_a);
+	nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+	auto cookie_it (shard_l.cookies.find (endpoint_a));
+	if (cookie_it != shard_l.cookies.end ())
 	{
 		auto cookie = cookie_it->second.cookie;
-		cookies.erase (cookie_it);
-		unsigned & ip_cookies = cookies_per_ip[ip_addr];
-		if (ip_cookies > 0)
-		{
-			--ip_cookies;
-		}
-		else
-		{
-			debug_assert (false && "More SYN cookies deleted than created for IP");
-		}
+		shard_l.erase (cookie_it);
 		return cookie;
 	}
 	return std::nullopt;
@@ -927,14 +1049,20 @@ std::optional<nano::uint256_union> nano::syn_cookies::cookie (const nano::endpoi
 
 std::size_t nano::syn_cookies::cookies_size ()
 {
-	nano::lock_guard<nano::mutex> lock{ syn_cookie_mutex };
-	return cookies.size ();
+	std::size_t result = 0;
+	for (auto & shard_l : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard_l.mutex };
+		result += shard_l.cookies.size ();
+	}
+	return result;
 }
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (network & network, std::string const & name)
 {
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (network.tcp_channels.collect_container_info ("tcp_channels"));
+	composite->add_component (network.tcp_message_manager.collect_container_info ("tcp_message_manager"));
 	composite->add_component (network.syn_cookies.collect_container_info ("syn_cookies"));
 	composite->add_component (network.excluded_peers.collect_container_info ("excluded_peers"));
 	return composite;
@@ -942,15 +1070,16 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ne
 
 std::unique_ptr<nano::container_info_component> nano::syn_cookies::collect_container_info (std::string const & name)
 {
-	std::size_t syn_cookies_count;
-	std::size_t syn_cookies_per_ip_count;
+	std::size_t syn_cookies_count = 0;
+	std::size_t syn_cookies_per_ip_count = 0;
+	for (auto & shard_l : shards)
 	{
-		nano::lock_guard<nano::mutex> syn_cookie_guard{ syn_cookie_mutex };
-		syn_cookies_count = cookies.size ();
-		syn_cookies_per_ip_count = cookies_per_ip.size ();
+		nano::lock_guard<nano::mutex> syn_cookie_guard{ shard_l.mutex };
+		syn_cookies_count += shard_l.cookies.size ();
+		syn_cookies_per_ip_count += shard_l.cookies_per_ip.size ();
 	}
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "syn_cookies", syn_cookies_count, sizeof (decltype (cookies)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "syn_cookies_per_ip", syn_cookies_per_ip_count, sizeof (decltype (cookies_per_ip)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "syn_cookies", syn_cookies_count, sizeof (decltype (shard::cookies)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "syn_cookies_per_ip", syn_cookies_per_ip_count, sizeof (decltype (shard::cookies_per_ip)::value_type) }));
 	return composite;
 }
@@ -8,6 +8,7 @@
 
 #include <boost/thread/thread.hpp>
 
+#include <array>
 #include <deque>
 #include <memory>
 #include <unordered_set>
@@ -16,29 +17,75 @@ namespace nano
 {
 class node;
 
+/**
+ * Inbound realtime messages waiting for the packet processing threads.
+ * Every peer gets its own bounded queues so a single noisy peer only overflows its own queue,
+ * peers are drained round robin. Votes, blocks and confirmation requests are queued with priority
+ * and are served ahead of other traffic, with a share of every round reserved for the rest so it does not starve.
+ */
 class tcp_message_manager final
 {
 public:
-	tcp_message_manager (unsigned incoming_connections_max_a);
-	void put_message (nano::tcp_message_item const & item_a);
+	enum class priority
+	{
+		high,
+		normal,
+	};
+
+	explicit tcp_message_manager (nano::stats &, std::size_t max_entries_per_peer = default_max_entries_per_peer);
+
+	/**
+	 * Queues the message, dropping it if the queue of the sending peer is full
+	 * @return true if the message was dropped
+	 */
+	bool put_message (nano::tcp_message_item const & item_a);
+	/** Blocks until a message is available, returns an item with no message once stopped */
 	nano::tcp_message_item get_message ();
 	// Stop container and notify waiting threads
 	void stop ();
 
+	std::size_t size () const;
+	/** Number of messages queued from \p endpoint_a */
+	std::size_t size (nano::tcp_endpoint const & endpoint_a) const;
+
+	static priority priority_of (nano::tcp_message_item const &);
+
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name);
+
+	static std::size_t constexpr default_max_entries_per_peer = 64;
+	/** Out of this many consecutive messages at most all but one are taken from the high priority queues while normal messages are waiting */
+	static std::size_t constexpr high_priority_ratio = 4;
+
+private: // Dependencies
+	nano::stats & stats;
+
 private:
-	nano::mutex mutex;
-	nano::condition_variable producer_condition;
-	nano::condition_variable consumer_condition;
-	std::deque<nano::tcp_message_item> entries;
-	unsigned max_entries;
-	static unsigned const max_entries_per_connection = 16;
-	bool stopped{ false };
+	class peer_queue final
+	{
+	public:
+		std::array<std::deque<nano::tcp_message_item>, 2> queues;
+
+		bool empty () const;
+		std::size_t size () const;
+	};
+
+	/** Pops the next message of the first peer in the round robin order of \p priority_a */
+	nano::tcp_message_item pop (priority priority_a);
 
-	friend class network_tcp_message_manager_Test;
+	std::size_t const max_entries_per_peer;
+	std::unordered_map<nano::tcp_endpoint, peer_queue> peers;
+	/** Peers with messages queued at the given priority, in round robin order */
+	std::array<std::deque<nano::tcp_endpoint>, 2> ready;
+	std::size_t total{ 0 };
+	std::size_t high_streak{ 0 };
+	bool stopped{ false };
+	mutable nano::mutex mutex;
+	nano::condition_variable condition;
 };
 
 /**
  * Node ID cookies for node ID handshakes
+ * Cookies are sharded by IP address, so the per IP limits are enforced within a single shard
  */
 class syn_cookies final
 {
@@ -65,9 +112,21 @@ private:
 		nano::uint256_union cookie;
 		std::chrono::steady_clock::time_point created_at;
 	};
-	mutable nano::mutex syn_cookie_mutex;
-	std::unordered_map<nano::endpoint, syn_cookie_info> cookies;
-	std::unordered_map<boost::asio::ip::address, unsigned> cookies_per_ip;
+	class shard final
+	{
+	public:
+		mutable nano::mutex mutex;
+		std::unordered_map<nano::endpoint, syn_cookie_info> cookies;
+		std::unordered_map<boost::asio::ip::address, unsigned> cookies_per_ip;
+
+		/** Erases the cookie and decrements the per IP count, must be called with the mutex held */
+		void erase (std::unordered_map<nano::endpoint, syn_cookie_info>::iterator);
+	};
+
+	shard & shard_for (nano::endpoint const &);
+
+	static std::size_t constexpr shard_count = 16;
+	std::array<shard, shard_count> shards;
 	std::size_t max_cookies_per_ip;
 };
 
@@ -85,6 +144,8 @@ public:
 	void flood_keepalive_self (float const scale_a = 0.5f);
 	void flood_vote (std::shared_ptr<nano::vote> const &, float scale);
 	void flood_vote_pr (std::shared_ptr<nano::vote> const &);
+	/** Floods the votes to principal representatives and to a random fanout, each vote is serialized once and the peer lists are fetched once for the whole batch */
+	void flood_votes (std::vector<std::shared_ptr<nano::vote>> const &, float scale);
 	// Flood block to all PRs and a random selection of non-PRs
 	void flood_block_initial (std::shared_ptr<nano::block> const &);
 	// Flood block to a random selection of peers
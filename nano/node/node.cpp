@@ -12,6 +12,7 @@
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/telemetry.hpp>
 #include <nano/node/websocket.hpp>
+#include <nano/store/block.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 
@@ -139,7 +140,7 @@ nano::node::node (boost::asio::io_context & io_ctx_a, uint16_t peering_port_a, s
 
 nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path const & application_path_a, nano::node_config const & config_a, nano::work_pool & work_a, nano::node_flags flags_a, unsigned seq) :
 	node_id{ load_or_create_node_id (application_path_a) },
-	write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable)),
+	write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable), stats),
 	io_ctx (io_ctx_a),
 	node_initialized_latch (1),
 	config (config_a),
@@ -153,7 +154,7 @@ nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path cons
 	distributed_work (*this),
 	store_impl (nano::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade)),
 	store (*store_impl),
-	unchecked{ config.max_unchecked_blocks, stats, flags.disable_block_processor_unchecked_deletion },
+	unchecked{ config.max_unchecked_blocks, stats, flags.disable_block_processor_unchecked_deletion, config.max_unchecked_memory },
 	wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
 	ledger (store, stats, network_params.ledger, flags_a.generate_cache),
@@ -176,16 +177,17 @@ nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path cons
 	application_path (application_path_a),
 	port_mapping (*this),
 	rep_crawler (*this),
-	vote_processor (active, observers, stats, config, flags, logger, online_reps, rep_crawler, ledger, network_params),
+	checker{ stats, config.signature_checker_threads },
+	vote_processor (checker, active, observers, stats, config, flags, logger, online_reps, rep_crawler, ledger, network_params),
 	warmed_up (0),
 	block_processor (*this, write_database_queue),
 	online_reps (ledger, config),
 	history{ config.network_params.voting },
 	vote_uniquer{},
-	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
+	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, logger, node_initialized_latch, flags.confirmation_height_processor_mode, config.conf_height_processor_discovery_threads),
 	vote_cache{ config.vote_cache, stats },
-	generator{ config, ledger, wallets, vote_processor, history, network, stats, logger, /* non-final */ false },
-	final_generator{ config, ledger, wallets, vote_processor, history, network, stats, logger, /* final */ true },
+	generator{ config, ledger, wallets, vote_processor, history, network, workers, stats, logger, /* non-final */ false },
+	final_generator{ config, ledger, wallets, vote_processor, history, network, workers, stats, logger, /* final */ true },
 	active{ *this, confirmation_height_processor, block_processor },
 	scheduler_impl{ std::make_unique<nano::scheduler::component> (*this) },
 	scheduler{ *scheduler_impl },
@@ -205,8 +207,14 @@ nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path cons
 	block_broadcast.connect (block_processor);
 	process_live_dispatcher.connect (block_processor);
 
-	unchecked.satisfied.add ([this] (nano::unchecked_info const & info) {
-		this->block_processor.add (info.block);
+	unchecked.satisfied.add ([this] (std::deque<nano::unchecked_info> const & infos) {
+		std::vector<std::shared_ptr<nano::block>> blocks;
+		blocks.reserve (infos.size ());
+		for (auto const & info : infos)
+		{
+			blocks.push_back (info.block);
+		}
+		this->block_processor.add (blocks);
 	});
 
 	vote_cache.rep_weight_query = [this] (nano::account const & rep) {
@@ -218,6 +226,14 @@ nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path cons
 		scheduler.optimistic.activate (account, account_info, conf_info);
 	});
 
+	store.block.cache.attach (stats);
+	store.block.cache.set_max_memory (config.block_cache_max_memory);
+
+	if (!config.rocksdb_config.enable && config.lmdb_config.sync == nano::lmdb_config::sync_strategy::group_commit)
+	{
+		write_database_queue.enable_group_commit ([this] () { store.flush (); }, [this] (bool defer) { store.defer_sync (defer); });
+	}
+
 	if (!init_error ())
 	{
 		// Notify election schedulers when AEC frees election slot
@@ -364,7 +380,7 @@ nano::node::node (boost::asio::io_context & io_ctx_a, std::filesystem::path cons
 
 		if (!is_initialized && !flags.read_only)
 		{
-			auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers }));
+			auto const transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::delegators, tables::frontiers }));
 			// Store was empty meaning we just created it, add the genesis block
 			store.initialize (transaction, ledger.cache, ledger.constants);
 		}
@@ -527,6 +543,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	composite->add_component (nano::store::collect_container_info (node.store.block.cache, "block_cache"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (*node.tcp_listener, "tcp_listener"));
@@ -536,6 +553,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.observers, "observers"));
 	composite->add_component (collect_container_info (node.wallets, "wallets"));
 	composite->add_component (collect_container_info (node.vote_processor, "vote_processor"));
+	composite->add_component (collect_container_info (node.checker, "signature_checker"));
 	composite->add_component (collect_container_info (node.rep_crawler, "rep_crawler"));
 	composite->add_component (collect_container_info (node.block_processor, "block_processor"));
 	composite->add_component (collect_container_info (node.block_arrival, "block_arrival"));
@@ -568,7 +586,7 @@ void nano::node::process_active (std::shared_ptr<nano::block> const & incoming)
 
 nano::process_return nano::node::process (nano::block & block)
 {
-	auto const transaction = store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending });
+	auto const transaction = store.tx_begin_write ({ tables::accounts, tables::blocks, tables::delegators, tables::frontiers, tables::pending });
 	return process (transaction, block);
 }
 
@@ -690,6 +708,7 @@ void nano::node::stop ()
 	block_processor.stop ();
 	aggregator.stop ();
 	vote_processor.stop ();
+	checker.stop ();
 	scheduler.stop ();
 	active.stop ();
 	generator.stop ();
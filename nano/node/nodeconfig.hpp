@@ -12,9 +12,11 @@
 #include <nano/node/ipc/ipc_config.hpp>
 #include <nano/node/scheduler/hinted.hpp>
 #include <nano/node/scheduler/optimistic.hpp>
+#include <nano/node/unchecked_map.hpp>
 #include <nano/node/vote_cache.hpp>
 #include <nano/node/websocketconfig.hpp>
 #include <nano/secure/common.hpp>
+#include <nano/store/block_cache.hpp>
 
 #include <chrono>
 #include <optional>
@@ -67,8 +69,10 @@ public:
 	unsigned network_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned work_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned background_threads{ std::max (4u, nano::hardware_concurrency ()) };
-	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
+	/* Use half available threads on the system for batched signature checking of votes and blocks */
 	unsigned signature_checker_threads{ std::max (2u, nano::hardware_concurrency () / 2) };
+	/* Number of vote processor shards, each drained by its own thread */
+	unsigned vote_processor_threads{ std::max (1u, std::min (4u, nano::hardware_concurrency () / 4)) };
 	bool enable_voting{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
@@ -113,10 +117,16 @@ public:
 	double bootstrap_bandwidth_burst_ratio{ 1. };
 	nano::bootstrap_ascending_config bootstrap_ascending;
 	std::chrono::milliseconds conf_height_processor_batch_min_time{ 50 };
+	unsigned conf_height_processor_discovery_threads{ 0 };
 	bool backup_before_upgrade{ false };
 	double max_work_generate_multiplier{ 64. };
 	uint32_t max_queued_requests{ 512 };
+	unsigned request_aggregator_threads{ std::min (4u, std::max (1u, nano::hardware_concurrency () / 4)) };
 	unsigned max_unchecked_blocks{ 65536 };
+	/** Memory budget of unchecked blocks, in bytes */
+	std::size_t max_unchecked_memory{ nano::unchecked_map::default_max_memory };
+	/** Memory budget of the decoded block cache in front of the block store, in bytes */
+	std::size_t block_cache_max_memory{ nano::store::block_cache::default_max_memory };
 	std::chrono::seconds max_pruning_age{ !network_params.network.is_beta_network () ? std::chrono::seconds (24 * 60 * 60) : std::chrono::seconds (5 * 60) }; // 1 day; 5 minutes for beta network
 	uint64_t max_pruning_depth{ 0 };
 	nano::rocksdb_config rocksdb_config;
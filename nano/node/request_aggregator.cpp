@@ -9,6 +9,10 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/store/component.hpp>
 
+#include <array>
+
+using namespace std::chrono_literals;
+
 nano::request_aggregator::request_aggregator (nano::node_config const & config_a, nano::stats & stats_a, nano::vote_generator & generator_a, nano::vote_generator & final_generator_a, nano::local_vote_history & history_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::active_transactions & active_a) :
 	config{ config_a },
 	max_delay (config_a.network_params.network.is_dev_network () ? 50 : 300),
@@ -20,8 +24,7 @@ nano::request_aggregator::request_aggregator (nano::node_config const & config_a
 	wallets (wallets_a),
 	active (active_a),
 	generator (generator_a),
-	final_generator (final_generator_a),
-	thread ([this] () { run (); })
+	final_generator (final_generator_a)
 {
 	generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
 		this->reply_action (vote_a, channel_a);
@@ -29,8 +32,13 @@ nano::request_aggregator::request_aggregator (nano::node_config const & config_a
 	final_generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
 		this->reply_action (vote_a, channel_a);
 	});
+	auto const thread_count = std::max (1u, config.request_aggregator_threads);
+	for (auto i = 0u; i < thread_count; ++i)
+	{
+		threads.emplace_back ([this] () { run (); });
+	}
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	condition.wait (lock, [&started = started] { return started; });
+	condition.wait (lock, [this, thread_count] { return started == thread_count; });
 }
 
 // TODO: This is badly implemented, will prematurely drop large vote requests
@@ -74,41 +82,35 @@ void nano::request_aggregator::run ()
 {
 	nano::thread_role::set (nano::thread_role::name::request_aggregator);
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	started = true;
+	++started;
 	lock.unlock ();
 	condition.notify_all ();
 	lock.lock ();
+	std::vector<batch_entry> batch;
 	while (!stopped)
 	{
 		if (!requests.empty ())
 		{
 			auto & requests_by_deadline (requests.get<tag_deadline> ());
+			auto const now = std::chrono::steady_clock::now ();
 			auto front (requests_by_deadline.begin ());
-			if (front->deadline < std::chrono::steady_clock::now ())
+			if (front->deadline < now)
 			{
-				// Store the channel and requests for processing after erasing this pool
-				decltype (front->channel) channel{};
-				decltype (front->hashes_roots) hashes_roots{};
-				requests_by_deadline.modify (front, [&channel, &hashes_roots] (channel_pool & pool) {
-					channel.swap (pool.channel);
-					hashes_roots.swap (pool.hashes_roots);
-				});
-				requests_by_deadline.erase (front);
-				lock.unlock ();
-				erase_duplicates (hashes_roots);
-				auto const remaining = aggregate (hashes_roots, channel);
-				if (!remaining.first.empty ())
-				{
-					// Generate votes for the remaining hashes
-					auto const generated = generator.generate (remaining.first, channel);
-					stats.add (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote, stat::dir::in, remaining.first.size () - generated);
-				}
-				if (!remaining.second.empty ())
+				// Take all expired pools up to the batch limit, other threads pick up the rest
+				while (front != requests_by_deadline.end () && front->deadline < now && batch.size () < max_batch_pools)
 				{
-					// Generate final votes for the remaining hashes
-					auto const generated = final_generator.generate (remaining.second, channel);
-					stats.add (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote, stat::dir::in, remaining.second.size () - generated);
+					// Store the channel and requests for processing after erasing this pool
+					batch_entry entry{ nullptr, {}, front->start };
+					requests_by_deadline.modify (front, [&entry] (channel_pool & pool) {
+						entry.channel.swap (pool.channel);
+						entry.hashes_roots.swap (pool.hashes_roots);
+					});
+					front = requests_by_deadline.erase (front);
+					batch.push_back (std::move (entry));
 				}
+				lock.unlock ();
+				process (batch);
+				batch.clear ();
 				lock.lock ();
 			}
 			else
@@ -124,6 +126,63 @@ void nano::request_aggregator::run ()
 	}
 }
 
+void nano::request_aggregator::process (std::vector<batch_entry> & batch)
+{
+	std::vector<std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>>> remaining;
+	remaining.reserve (batch.size ());
+	{
+		// A single read transaction for the whole batch
+		auto transaction (ledger.store.tx_begin_read ());
+		for (auto & entry : batch)
+		{
+			erase_duplicates (entry.hashes_roots);
+			remaining.push_back (aggregate (transaction, entry.hashes_roots, entry.channel));
+		}
+	}
+	for (std::size_t i = 0; i < batch.size (); ++i)
+	{
+		auto & entry = batch[i];
+		auto const & [to_generate, to_generate_final] = remaining[i];
+		if (!to_generate.empty ())
+		{
+			// Generate votes for the remaining hashes
+			auto const generated = generator.generate (to_generate, entry.channel);
+			stats.add (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote, stat::dir::in, to_generate.size () - generated);
+		}
+		if (!to_generate_final.empty ())
+		{
+			// Generate final votes for the remaining hashes
+			auto const generated = final_generator.generate (to_generate_final, entry.channel);
+			stats.add (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote, stat::dir::in, to_generate_final.size () - generated);
+		}
+		stats.inc_detail_only (nano::stat::type::aggregator, latency_detail (std::chrono::steady_clock::now () - entry.start));
+	}
+}
+
+nano::stat::detail nano::request_aggregator::latency_detail (std::chrono::steady_clock::duration latency_a)
+{
+	// Pools are deliberately held for small_delay (10ms dev, 50ms live) up to max_delay (50ms dev, 300ms live)
+	// so bucket edges are spread over that range, with a few more to show how far processing lags behind it
+	static std::array<std::pair<std::chrono::milliseconds, nano::stat::detail>, 8> constexpr buckets{ {
+	{ 10ms, nano::stat::detail::aggregator_latency_under_10ms },
+	{ 25ms, nano::stat::detail::aggregator_latency_under_25ms },
+	{ 50ms, nano::stat::detail::aggregator_latency_under_50ms },
+	{ 100ms, nano::stat::detail::aggregator_latency_under_100ms },
+	{ 200ms, nano::stat::detail::aggregator_latency_under_200ms },
+	{ 300ms, nano::stat::detail::aggregator_latency_under_300ms },
+	{ 500ms, nano::stat::detail::aggregator_latency_under_500ms },
+	{ 1000ms, nano::stat::detail::aggregator_latency_under_1s },
+	} };
+	for (auto const & [edge, detail] : buckets)
+	{
+		if (latency_a < edge)
+		{
+			return detail;
+		}
+	}
+	return nano::stat::detail::aggregator_latency_over_1s;
+}
+
 void nano::request_aggregator::stop ()
 {
 	{
@@ -131,9 +190,12 @@ void nano::request_aggregator::stop ()
 		stopped = true;
 	}
 	condition.notify_all ();
-	if (thread.joinable ())
+	for (auto & thread : threads)
 	{
-		thread.join ();
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
 	}
 }
 
@@ -165,9 +227,8 @@ void nano::request_aggregator::erase_duplicates (std::vector<std::pair<nano::blo
 	requests_a.end ());
 }
 
-std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>> nano::request_aggregator::aggregate (std::vector<std::pair<nano::block_hash, nano::root>> const & requests_a, std::shared_ptr<nano::transport::channel> & channel_a) const
+std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>> nano::request_aggregator::aggregate (store::transaction const & transaction, std::vector<std::pair<nano::block_hash, nano::root>> const & requests_a, std::shared_ptr<nano::transport::channel> & channel_a) const
 {
-	auto transaction (ledger.store.tx_begin_read ());
 	std::vector<std::shared_ptr<nano::block>> to_generate;
 	std::vector<std::shared_ptr<nano::block>> to_generate_final;
 	std::vector<std::shared_ptr<nano::vote>> cached_votes;
@@ -2,6 +2,7 @@
 
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/stats_enums.hpp>
 #include <nano/node/transport/channel.hpp>
 #include <nano/node/transport/transport.hpp>
 
@@ -23,6 +24,10 @@ class ledger;
 class local_vote_history;
 class node_config;
 class stats;
+namespace store
+{
+	class transaction;
+}
 class vote_generator;
 class wallets;
 
@@ -33,6 +38,9 @@ class wallets;
  * * A request arrives for hashes {1,4,5}. Another request arrives soon afterwards for hashes {2,3,6}
  * * The aggregator will reply with the two cached votes
  * Votes are generated for uncached hashes.
+ * Pools are served by several threads, each taking a batch of expired pools and looking them all up in a single read transaction.
+ * The time from the first request of a pool until cached votes are sent and the rest is queued for vote generation
+ * is counted in the `aggregator_latency_*` buckets, whose edges span the small_delay to max_delay holding time and beyond.
  */
 class request_aggregator final
 {
@@ -74,14 +82,28 @@ public:
 	std::chrono::milliseconds const max_delay;
 	std::chrono::milliseconds const small_delay;
 	std::size_t const max_channel_requests;
+	/** Maximum number of expired pools taken by a thread at once */
+	static std::size_t constexpr max_batch_pools{ 32 };
 
 private:
+	/** A pool taken out of the queue for processing */
+	class batch_entry final
+	{
+	public:
+		std::shared_ptr<nano::transport::channel> channel;
+		std::vector<std::pair<nano::block_hash, nano::root>> hashes_roots;
+		std::chrono::steady_clock::time_point start;
+	};
+
 	void run ();
+	void process (std::vector<batch_entry> &);
 	/** Remove duplicate requests **/
 	void erase_duplicates (std::vector<std::pair<nano::block_hash, nano::root>> &) const;
 	/** Aggregate \p requests_a and send cached votes to \p channel_a . Return the remaining hashes that need vote generation for each block for regular & final vote generators **/
-	std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>> aggregate (std::vector<std::pair<nano::block_hash, nano::root>> const & requests_a, std::shared_ptr<nano::transport::channel> & channel_a) const;
+	std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>> aggregate (store::transaction const &, std::vector<std::pair<nano::block_hash, nano::root>> const & requests_a, std::shared_ptr<nano::transport::channel> & channel_a) const;
 	void reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const;
+	/** Latency bucket counted for a processed pool */
+	static nano::stat::detail latency_detail (std::chrono::steady_clock::duration);
 
 	nano::stats & stats;
 	nano::local_vote_history & local_votes;
@@ -102,10 +124,10 @@ private:
 	// clang-format on
 
 	bool stopped{ false };
-	bool started{ false };
+	std::size_t started{ 0 };
 	nano::condition_variable condition;
 	nano::mutex mutex{ mutex_identifier (mutexes::request_aggregator) };
-	std::thread thread;
+	std::vector<std::thread> threads;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (request_aggregator &, std::string const &);
 };
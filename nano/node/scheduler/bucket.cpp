@@ -1,14 +1,17 @@
-#include <nano/lib/blocks.hpp>
+#include <nano/lib/utility.hpp>
 #include <nano/node/scheduler/bucket.hpp>
 
+#include <algorithm>
+#include <iostream>
+
 bool nano::scheduler::bucket::value_type::operator< (value_type const & other_a) const
 {
-	return time < other_a.time || (time == other_a.time && block->hash () < other_a.block->hash ());
+	return time < other_a.time || (time == other_a.time && hash < other_a.hash);
 }
 
 bool nano::scheduler::bucket::value_type::operator== (value_type const & other_a) const
 {
-	return time == other_a.time && block->hash () == other_a.block->hash ();
+	return time == other_a.time && hash == other_a.hash;
 }
 
 nano::scheduler::bucket::bucket (size_t maximum) :
@@ -21,42 +24,63 @@ nano::scheduler::bucket::~bucket ()
 {
 }
 
-std::shared_ptr<nano::block> nano::scheduler::bucket::top () const
+std::optional<nano::block_hash> nano::scheduler::bucket::top () const
 {
-	debug_assert (!queue.empty ());
-	return queue.begin ()->block;
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (queue.empty ())
+	{
+		return std::nullopt;
+	}
+	return queue.front ().hash;
 }
 
-void nano::scheduler::bucket::pop ()
+std::optional<nano::block_hash> nano::scheduler::bucket::pop ()
 {
-	debug_assert (!queue.empty ());
-	queue.erase (queue.begin ());
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (queue.empty ())
+	{
+		return std::nullopt;
+	}
+	auto result = queue.front ().hash;
+	queue.pop_front ();
+	return result;
 }
 
-void nano::scheduler::bucket::push (uint64_t time, std::shared_ptr<nano::block> block)
+bool nano::scheduler::bucket::push (uint64_t time, nano::block_hash const & hash)
 {
-	queue.insert ({ time, block });
+	value_type const value{ time, hash };
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto position = std::lower_bound (queue.begin (), queue.end (), value);
+	if (position != queue.end () && *position == value)
+	{
+		return false;
+	}
+	queue.insert (position, value);
 	if (queue.size () > maximum)
 	{
-		debug_assert (!queue.empty ());
-		queue.erase (--queue.end ());
+		queue.pop_back ();
+		return false;
 	}
+	return true;
 }
 
 size_t nano::scheduler::bucket::size () const
 {
+	nano::lock_guard<nano::mutex> lock{ mutex };
 	return queue.size ();
 }
 
 bool nano::scheduler::bucket::empty () const
 {
+	nano::lock_guard<nano::mutex> lock{ mutex };
 	return queue.empty ();
 }
 
 void nano::scheduler::bucket::dump () const
 {
+	nano::lock_guard<nano::mutex> lock{ mutex };
 	for (auto const & item : queue)
 	{
-		std::cerr << item.time << ' ' << item.block->hash ().to_string () << '\n';
+		std::cerr << item.time << ' ' << item.hash.to_string () << '\n';
 	}
 }
@@ -1,17 +1,18 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+
 #include <cstddef>
 #include <cstdint>
-#include <memory>
-#include <set>
+#include <deque>
+#include <optional>
 
-namespace nano
-{
-class block;
-}
 namespace nano::scheduler
 {
 /** A class which holds an ordered set of blocks to be scheduled, ordered by their block arrival time
+ *  Only the hash of each block is kept, the block is loaded from the ledger once it is scheduled.
+ *  Every operation takes the bucket's own lock, so producers filling different buckets do not contend.
  */
 class bucket final
 {
@@ -19,19 +20,23 @@ class bucket final
 	{
 	public:
 		uint64_t time;
-		std::shared_ptr<nano::block> block;
+		nano::block_hash hash;
 		bool operator< (value_type const & other_a) const;
 		bool operator== (value_type const & other_a) const;
 	};
-	std::set<value_type> queue;
+	/** Sorted by arrival time, arrival times mostly increase so new entries go close to the back */
+	std::deque<value_type> queue;
 	size_t const maximum;
+	mutable nano::mutex mutex;
 
 public:
 	bucket (size_t maximum);
 	~bucket ();
-	std::shared_ptr<nano::block> top () const;
-	void pop ();
-	void push (uint64_t time, std::shared_ptr<nano::block> block);
+	std::optional<nano::block_hash> top () const;
+	/** Removes and returns the oldest entry */
+	std::optional<nano::block_hash> pop ();
+	/** @return true if the bucket grew, false for duplicates or when the bucket is full and an entry was trimmed */
+	bool push (uint64_t time, nano::block_hash const & hash);
 	size_t size () const;
 	bool empty () const;
 	void dump () const;
@@ -1,28 +1,30 @@
-#include <nano/lib/blocks.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/scheduler/bucket.hpp>
 #include <nano/node/scheduler/buckets.hpp>
 
+#include <algorithm>
+#include <iostream>
 #include <string>
 
 /** Moves the bucket pointer to the next bucket */
 void nano::scheduler::buckets::next ()
 {
-	++current;
-	if (current == buckets_m.end ())
-	{
-		current = buckets_m.begin ();
-	}
+	auto next = current.load () + 1;
+	current = next == buckets_m.size () ? 0 : next;
 }
 
-/** Seek to the next non-empty bucket, if one exists */
-void nano::scheduler::buckets::seek ()
+std::optional<std::size_t> nano::scheduler::buckets::seek () const
 {
-	next ();
-	for (std::size_t i = 0, n = buckets_m.size (); (*current)->empty () && i < n; ++i)
+	auto const start = current.load ();
+	for (std::size_t i = 0, n = buckets_m.size (); i < n; ++i)
 	{
-		next ();
+		auto const index = (start + i) % n;
+		if (!buckets_m[index]->empty ())
+		{
+			return index;
+		}
 	}
+	return std::nullopt;
 }
 
 /**
@@ -49,12 +51,21 @@ nano::scheduler::buckets::buckets (uint64_t maximum) :
 	build_region (uint128_t{ 1 } << 112, uint128_t{ 1 } << 116, 4);
 	build_region (uint128_t{ 1 } << 116, uint128_t{ 1 } << 120, 2);
 	minimums.push_back (uint128_t{ 1 } << 120);
+	// Balances with the same leading bit fall between [2^bit, 2^(bit+1)), only the thresholds in between need to be searched
+	auto find = [this] (nano::uint128_t const & balance) -> std::size_t {
+		return std::upper_bound (minimums.begin (), minimums.end (), balance) - minimums.begin () - 1;
+	};
+	for (std::size_t bit = 0; bit < index_ranges.size (); ++bit)
+	{
+		auto const low = nano::uint128_t{ 1 } << bit;
+		auto const high = low + (low - 1);
+		index_ranges[bit] = { find (low), find (high) + 1 };
+	}
 	auto bucket_max = std::max<size_t> (1u, maximum / minimums.size ());
 	for (size_t i = 0u, n = minimums.size (); i < n; ++i)
 	{
 		buckets_m.push_back (std::make_unique<scheduler::bucket> (bucket_max));
 	}
-	current = buckets_m.begin ();
 }
 
 nano::scheduler::buckets::~buckets ()
@@ -63,7 +74,12 @@ nano::scheduler::buckets::~buckets ()
 
 std::size_t nano::scheduler::buckets::index (nano::uint128_t const & balance) const
 {
-	auto index = std::upper_bound (minimums.begin (), minimums.end (), balance) - minimums.begin () - 1;
+	if (balance.is_zero ())
+	{
+		return 0;
+	}
+	auto const [low, high] = index_ranges[boost::multiprecision::msb (balance)];
+	auto index = std::upper_bound (minimums.begin () + low, minimums.begin () + high, balance) - minimums.begin () - 1;
 	return index;
 }
 
@@ -71,43 +87,51 @@ std::size_t nano::scheduler::buckets::index (nano::uint128_t const & balance) co
  * Push a block and its associated time into the prioritization container.
  * The time is given here because sideband might not exist in the case of state blocks.
  */
-void nano::scheduler::buckets::push (uint64_t time, std::shared_ptr<nano::block> block, nano::amount const & priority)
+void nano::scheduler::buckets::push (uint64_t time, nano::block_hash const & hash, nano::amount const & priority)
 {
-	auto was_empty = empty ();
-	auto & bucket = buckets_m[index (priority.number ())];
-	bucket->push (time, block);
-	if (was_empty)
+	auto const index_l = index (priority.number ());
+	if (buckets_m[index_l]->push (time, hash))
 	{
-		seek ();
+		if (total++ <= 0)
+		{
+			// Start reading from this bucket as it is the only one with blocks
+			current = index_l;
+		}
 	}
 }
 
 /** Return the highest priority block of the current bucket */
-std::shared_ptr<nano::block> nano::scheduler::buckets::top () const
+nano::block_hash nano::scheduler::buckets::top () const
 {
 	debug_assert (!empty ());
-	auto result = (*current)->top ();
-	return result;
+	auto index = seek ();
+	debug_assert (index);
+	return index ? buckets_m[*index]->top ().value_or (0) : nano::block_hash{ 0 };
 }
 
-/** Pop the current block from the container and seek to the next block, if it exists */
-void nano::scheduler::buckets::pop ()
+/** Pop the current block from the container and move to the next bucket */
+std::optional<nano::block_hash> nano::scheduler::buckets::pop ()
 {
-	debug_assert (!empty ());
-	auto & bucket = *current;
-	bucket->pop ();
-	seek ();
+	auto index = seek ();
+	if (!index)
+	{
+		return std::nullopt;
+	}
+	current = *index;
+	auto result = buckets_m[*index]->pop ();
+	debug_assert (result);
+	if (result)
+	{
+		--total;
+	}
+	next ();
+	return result;
 }
 
 /** Returns the total number of blocks in buckets */
 std::size_t nano::scheduler::buckets::size () const
 {
-	std::size_t result{ 0 };
-	for (auto const & bucket : buckets_m)
-	{
-		result += bucket->size ();
-	}
-	return result;
+	return static_cast<std::size_t> (std::max<int64_t> (total, 0));
 }
 
 /** Returns number of buckets, 62 by default */
@@ -125,7 +149,7 @@ std::size_t nano::scheduler::buckets::bucket_size (std::size_t index) const
 /** Returns true if all buckets are empty */
 bool nano::scheduler::buckets::empty () const
 {
-	return std::all_of (buckets_m.begin (), buckets_m.end (), [] (auto const & bucket) { return bucket->empty (); });
+	return total <= 0;
 }
 
 /** Print the state of the class in stderr */
@@ -135,7 +159,7 @@ void nano::scheduler::buckets::dump () const
 	{
 		bucket->dump ();
 	}
-	std::cerr << "current: " << current - buckets_m.begin () << '\n';
+	std::cerr << "current: " << current.load () << '\n';
 }
 
 std::unique_ptr<nano::container_info_component> nano::scheduler::buckets::collect_container_info (std::string const & name)
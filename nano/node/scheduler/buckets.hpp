@@ -2,19 +2,18 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <memory>
+#include <optional>
+#include <vector>
 
-namespace nano
-{
-class block;
-}
 namespace nano::scheduler
 {
 class bucket;
-/** A container for holding blocks and their arrival/creation time.
+/** A container for holding block hashes and their arrival/creation time.
  *
  *  The container consists of a number of buckets. Each bucket holds an ordered set of 'value_type' items.
  *  The buckets are accessed in a round robin fashion. The index 'current' holds the index of the bucket to access next.
@@ -23,31 +22,42 @@ class bucket;
  *
  *  The arrival/creation time is only an approximation and it could even be wildly wrong,
  *  for example, in the event of bootstrapped blocks.
+ *
+ *  Any number of threads can push concurrently, each bucket has its own lock. `top` and `pop` must only be called by a single consumer.
  */
 class buckets final
 {
 	/** container for the buckets to be read in round robin fashion */
-	std::deque<std::unique_ptr<bucket>> buckets_m;
+	std::vector<std::unique_ptr<bucket>> buckets_m;
 
 	/** thresholds that define the bands for each bucket, the minimum balance an account must have to enter a bucket,
 	 *  the container writes a block to the lowest indexed bucket that has balance larger than the bucket's minimum value */
-	std::deque<nano::uint128_t> minimums;
+	std::vector<nano::uint128_t> minimums;
+
+	/** for each leading bit of a balance, the range of `minimums` that can contain its bucket, so finding the bucket only searches a handful of thresholds */
+	std::array<std::pair<std::size_t, std::size_t>, 128> index_ranges;
+
+	/** index of bucket to read next, advanced by the consumer and moved to the pushed bucket by a push into an empty container */
+	std::atomic<std::size_t> current{ 0 };
 
-	/** index of bucket to read next */
-	decltype (buckets_m)::const_iterator current;
+	/** total number of blocks in all buckets, kept separately so checking for work does not lock every bucket
+	 *  signed because a pop can be counted before the push that made it possible, readers clamp it at zero */
+	std::atomic<int64_t> total{ 0 };
 
 	/** maximum number of blocks in whole container, each bucket's maximum is maximum / bucket_number */
 	uint64_t const maximum;
 
 	void next ();
-	void seek ();
+	/** Returns the index of the first non-empty bucket starting from current, if one exists */
+	std::optional<std::size_t> seek () const;
 
 public:
 	buckets (uint64_t maximum = 250000u);
 	~buckets ();
-	void push (uint64_t time, std::shared_ptr<nano::block> block, nano::amount const & priority);
-	std::shared_ptr<nano::block> top () const;
-	void pop ();
+	void push (uint64_t time, nano::block_hash const & hash, nano::amount const & priority);
+	nano::block_hash top () const;
+	/** Removes the highest priority block of the current bucket and moves on to the next bucket */
+	std::optional<nano::block_hash> pop ();
 	std::size_t size () const;
 	std::size_t bucket_count () const;
 	std::size_t bucket_size (std::size_t index) const;
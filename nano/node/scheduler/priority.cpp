@@ -62,8 +62,8 @@ bool nano::scheduler::priority::activate (nano::account const & account_a, store
 				nano::log::arg{ "time", info->modified },
 				nano::log::arg{ "priority", balance_priority });
 
-				nano::lock_guard<nano::mutex> lock{ mutex };
-				buckets->push (info->modified, block, balance_priority);
+				// Buckets are synchronized internally, pushing does not take the scheduler mutex
+				buckets->push (info->modified, hash, balance_priority);
 				notify ();
 
 				return true; // Activated
@@ -80,19 +80,12 @@ void nano::scheduler::priority::notify ()
 
 std::size_t nano::scheduler::priority::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	return buckets->size ();
 }
 
-bool nano::scheduler::priority::empty_locked () const
-{
-	return buckets->empty ();
-}
-
 bool nano::scheduler::priority::empty () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return empty_locked ();
+	return buckets->empty ();
 }
 
 bool nano::scheduler::priority::predicate () const
@@ -105,7 +98,8 @@ void nano::scheduler::priority::run ()
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
-		condition.wait (lock, [this] () {
+		// Producers notify without taking the mutex, the bounded wait picks up a notification that raced with the predicate check
+		condition.wait_for (lock, std::chrono::milliseconds{ 100 }, [this] () {
 			return stopped || predicate ();
 		});
 		debug_assert ((std::this_thread::yield (), true)); // Introduce some random delay in debug builds
@@ -113,36 +107,43 @@ void nano::scheduler::priority::run ()
 		{
 			stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::loop);
 
+			lock.unlock ();
 			if (predicate ())
 			{
-				auto block = buckets->top ();
-				buckets->pop ();
-				lock.unlock ();
-				stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::insert_priority);
-				auto result = node.active.insert (block);
-				if (result.inserted)
+				if (auto hash = buckets->pop ())
 				{
-					stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::insert_priority_success);
-				}
-				if (result.election != nullptr)
-				{
-					result.election->transition_active ();
+					schedule (*hash);
 				}
 			}
-			else
-			{
-				lock.unlock ();
-			}
 			notify ();
 			lock.lock ();
 		}
 	}
 }
 
-std::unique_ptr<nano::container_info_component> nano::scheduler::priority::collect_container_info (std::string const & name)
+void nano::scheduler::priority::schedule (nano::block_hash const & hash)
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
+	// Buckets only keep hashes, the block could have been rolled back since it was activated
+	auto block = node.ledger.store.block.get (node.store.tx_begin_read (), hash);
+	if (block == nullptr)
+	{
+		stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::missing_block);
+		return;
+	}
+	stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::insert_priority);
+	auto result = node.active.insert (block);
+	if (result.inserted)
+	{
+		stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::insert_priority_success);
+	}
+	if (result.election != nullptr)
+	{
+		result.election->transition_active ();
+	}
+}
 
+std::unique_ptr<nano::container_info_component> nano::scheduler::priority::collect_container_info (std::string const & name)
+{
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (buckets->collect_container_info ("buckets"));
 	return composite;
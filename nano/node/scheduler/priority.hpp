@@ -47,9 +47,11 @@ private: // Dependencies
 
 private:
 	void run ();
-	bool empty_locked () const;
 	bool predicate () const;
+	/** Loads the block and starts its election */
+	void schedule (nano::block_hash const &);
 
+	/** Synchronized internally, pushed to by block processing and popped by the scheduler thread */
 	std::unique_ptr<nano::scheduler::buckets> buckets;
 
 	bool stopped{ false };
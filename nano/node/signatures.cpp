@@ -0,0 +1,160 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/node/signatures.hpp>
+
+#include <algorithm>
+
+void nano::signature_check_set::add (nano::public_key const & public_key, nano::uint256_union const & message, nano::signature const & signature)
+{
+	public_keys.push_back (public_key);
+	messages.push_back (message);
+	signatures.push_back (signature);
+}
+
+std::size_t nano::signature_check_set::size () const
+{
+	return messages.size ();
+}
+
+bool nano::signature_check_set::empty () const
+{
+	return messages.empty ();
+}
+
+bool nano::signature_check_set::valid (std::size_t index) const
+{
+	debug_assert (verifications.size () == size ());
+	return verifications[index] == 1;
+}
+
+/*
+ * signature_checker
+ */
+
+nano::signature_checker::signature_checker (nano::stats & stats_a, unsigned num_threads, std::size_t max_queue_a) :
+	stats{ stats_a },
+	max_queue{ std::max<std::size_t> (1, max_queue_a) }
+{
+	for (auto i = 0u; i < num_threads; ++i)
+	{
+		threads.emplace_back ([this] () {
+			nano::thread_role::set (nano::thread_role::name::signature_checking);
+			run ();
+		});
+	}
+}
+
+nano::signature_checker::~signature_checker ()
+{
+	stop ();
+}
+
+void nano::signature_checker::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	for (auto & thread : threads)
+	{
+		nano::join_or_pass (thread);
+	}
+}
+
+bool nano::signature_checker::add (nano::signature_check_set && set, callback_t callback)
+{
+	if (threads.empty ())
+	{
+		verify_impl (set);
+		callback (set);
+		return false;
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	if (queue.size () >= max_queue)
+	{
+		stats.inc (nano::stat::type::signature_checker, nano::stat::detail::overfill);
+		condition.wait (lock, [this] () { return stopped || queue.size () < max_queue; });
+	}
+	if (stopped)
+	{
+		return true;
+	}
+	queue.emplace_back (std::move (set), std::move (callback));
+	lock.unlock ();
+	condition.notify_all ();
+	return false;
+}
+
+void nano::signature_checker::verify (nano::signature_check_set & set)
+{
+	verify_impl (set);
+}
+
+std::size_t nano::signature_checker::size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return queue.size ();
+}
+
+void nano::signature_checker::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	// Keep going until the queue is drained so that every accepted set gets its callback
+	while (!stopped || !queue.empty ())
+	{
+		if (!queue.empty ())
+		{
+			auto [set, callback] = std::move (queue.front ());
+			queue.pop_front ();
+			lock.unlock ();
+			condition.notify_all ();
+
+			verify_impl (set);
+			callback (set);
+
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+void nano::signature_checker::verify_impl (nano::signature_check_set & set)
+{
+	auto const size = set.size ();
+	set.verifications.assign (size, 0);
+	if (size == 0)
+	{
+		return;
+	}
+	std::vector<unsigned char const *> messages (size);
+	std::vector<std::size_t> lengths (size, sizeof (nano::uint256_union));
+	std::vector<unsigned char const *> public_keys (size);
+	std::vector<unsigned char const *> signatures (size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		messages[i] = set.messages[i].bytes.data ();
+		public_keys[i] = set.public_keys[i].bytes.data ();
+		signatures[i] = set.signatures[i].bytes.data ();
+	}
+	for (std::size_t offset = 0; offset < size; offset += batch_size)
+	{
+		auto const count = std::min (batch_size, size - offset);
+		nano::validate_message_batch (messages.data () + offset, lengths.data () + offset, public_keys.data () + offset, signatures.data () + offset, count, set.verifications.data () + offset);
+	}
+	auto const invalid = static_cast<uint64_t> (std::count (set.verifications.begin (), set.verifications.end (), 0));
+	stats.inc (nano::stat::type::signature_checker, nano::stat::detail::batch);
+	stats.add (nano::stat::type::signature_checker, nano::stat::detail::ok, nano::stat::dir::in, size - invalid);
+	stats.add (nano::stat::type::signature_checker, nano::stat::detail::invalid, nano::stat::dir::in, invalid);
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (signature_checker & checker, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queue", checker.size (), sizeof (decltype (checker.queue)::value_type) }));
+	return composite;
+}
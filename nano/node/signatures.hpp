@@ -0,0 +1,82 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace nano
+{
+class stats;
+
+/**
+ * A set of 32 byte messages (block or vote hashes) with the public keys and signatures to verify them against
+ */
+class signature_check_set final
+{
+public:
+	void add (nano::public_key const &, nano::uint256_union const & message, nano::signature const &);
+	std::size_t size () const;
+	bool empty () const;
+	/** Only meaningful once the set has been verified */
+	bool valid (std::size_t index) const;
+
+	std::vector<nano::public_key> public_keys;
+	std::vector<nano::uint256_union> messages;
+	std::vector<nano::signature> signatures;
+	/** Filled in by the verification, 1 for valid signatures and 0 otherwise */
+	std::vector<int> verifications;
+};
+
+/**
+ * Multi-threaded signature verification service.
+ * Sets are queued by any number of producers and verified with the ed25519 batch verification on a pool of threads,
+ * once a set is verified its completion callback is invoked from the verifying thread.
+ */
+class signature_checker final
+{
+public:
+	using callback_t = std::function<void (nano::signature_check_set &)>;
+
+	signature_checker (nano::stats &, unsigned num_threads, std::size_t max_queue = 64);
+	~signature_checker ();
+
+	void stop ();
+	/**
+	 * Queues the set for verification, the callback is called once all signatures in the set are verified.
+	 * Blocks while the queue is full. Sets queued before `stop ()` are still verified.
+	 * With no threads configured the set is verified on the calling thread.
+	 * @return true if the checker is stopped and the set was not queued
+	 */
+	bool add (nano::signature_check_set &&, callback_t);
+	/** Verifies the set on the calling thread, bypassing the queue */
+	void verify (nano::signature_check_set &);
+	std::size_t size () const;
+
+	/** Sets larger than this are verified in several batches, producers should split their work accordingly to spread it over all threads */
+	static std::size_t constexpr batch_size = 256;
+
+private:
+	void run ();
+	void verify_impl (nano::signature_check_set &);
+
+private: // Dependencies
+	nano::stats & stats;
+
+private:
+	std::size_t const max_queue;
+	std::deque<std::pair<nano::signature_check_set, callback_t>> queue;
+	bool stopped{ false };
+	mutable nano::mutex mutex;
+	nano::condition_variable condition;
+	std::vector<std::thread> threads;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (signature_checker &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (signature_checker &, std::string const & name);
+}
@@ -34,6 +34,16 @@ public:
 	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
 	nano::transport::traffic_type = nano::transport::traffic_type::generic);
 
+	/**
+	 * Sends \p message_a already serialized into \p buffer_a with `to_shared_const_buffer`.
+	 * Lets a message sent to many channels be serialized once and the buffer shared between all of them.
+	 */
+	void send (nano::message const & message_a,
+	nano::shared_const_buffer const & buffer_a,
+	std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr,
+	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
+	nano::transport::traffic_type = nano::transport::traffic_type::generic);
+
 	// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 	virtual void send_buffer (nano::shared_const_buffer const &,
 	std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr,
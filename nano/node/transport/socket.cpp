@@ -155,17 +155,25 @@ void nano::transport::socket::write_queued_messages ()
 		return;
 	}
 
-	auto next = send_queue.pop ();
-	if (!next)
+	auto next = std::make_shared<std::vector<write_queue::entry>> (send_queue.pop (max_write_batch, max_write_batch_bytes));
+	if (next->empty ())
 	{
 		return;
 	}
 
 	set_default_timeout ();
 
+	// Queued messages are merged into a single scatter-gather write
+	std::vector<boost::asio::const_buffer> buffers;
+	buffers.reserve (next->size ());
+	for (auto const & entry : *next)
+	{
+		buffers.insert (buffers.end (), entry.buffer.begin (), entry.buffer.end ());
+	}
+
 	write_in_progress = true;
-	nano::async_write (tcp_socket, next->buffer,
-	boost::asio::bind_executor (strand, [this_s = shared_from_this (), next /* `next` object keeps buffer in scope */] (boost::system::error_code ec, std::size_t size) {
+	nano::unsafe_async_write (tcp_socket, std::move (buffers),
+	boost::asio::bind_executor (strand, [this_s = shared_from_this (), next /* `next` object keeps buffers in scope */] (boost::system::error_code ec, std::size_t size) {
 		this_s->write_in_progress = false;
 
 		if (ec)
@@ -179,9 +187,12 @@ void nano::transport::socket::write_queued_messages ()
 			this_s->set_last_completion ();
 		}
 
-		if (next->callback)
+		for (auto const & entry : *next)
 		{
-			next->callback (ec, size);
+			if (entry.callback)
+			{
+				entry.callback (ec, ec ? 0 : entry.buffer.size ());
+			}
 		}
 
 		if (!ec)
@@ -381,32 +392,27 @@ bool nano::transport::socket::write_queue::insert (const buffer_t & buffer, call
 	return false; // Not queued
 }
 
-std::optional<nano::transport::socket::write_queue::entry> nano::transport::socket::write_queue::pop ()
+auto nano::transport::socket::write_queue::pop (std::size_t max_count, std::size_t max_bytes) -> std::vector<entry>
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 
-	auto try_pop = [this] (nano::transport::traffic_type type) -> std::optional<entry> {
+	std::vector<entry> result;
+	std::size_t bytes = 0;
+	auto try_pop = [this, &result, &bytes, max_count, max_bytes] (nano::transport::traffic_type type) {
 		auto & que = queues[type];
-		if (!que.empty ())
+		while (!que.empty () && result.size () < max_count && (result.empty () || bytes + que.front ().buffer.size () <= max_bytes))
 		{
-			auto item = que.front ();
+			bytes += que.front ().buffer.size ();
+			result.push_back (std::move (que.front ()));
 			que.pop ();
-			return item;
 		}
-		return std::nullopt;
 	};
 
 	// TODO: This is a very basic prioritization, implement something more advanced and configurable
-	if (auto item = try_pop (nano::transport::traffic_type::generic))
-	{
-		return item;
-	}
-	if (auto item = try_pop (nano::transport::traffic_type::bootstrap))
-	{
-		return item;
-	}
+	try_pop (nano::transport::traffic_type::generic);
+	try_pop (nano::transport::traffic_type::bootstrap);
 
-	return std::nullopt;
+	return result;
 }
 
 void nano::transport::socket::write_queue::clear ()
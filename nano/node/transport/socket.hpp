@@ -48,6 +48,9 @@ class socket final : public std::enable_shared_from_this<nano::transport::socket
 
 public:
 	static std::size_t constexpr default_max_queue_size = 128;
+	/** Limits of queued messages merged into a single write */
+	static std::size_t constexpr max_write_batch = 64;
+	static std::size_t constexpr max_write_batch_bytes = 64 * 1024;
 
 	enum class type_t
 	{
@@ -137,7 +140,8 @@ private:
 		explicit write_queue (std::size_t max_size);
 
 		bool insert (buffer_t const &, callback_t, nano::transport::traffic_type);
-		std::optional<entry> pop ();
+		/** Pops up to \p max_count entries, stopping before \p max_bytes would be exceeded. At least one entry is returned if any are queued. */
+		std::vector<entry> pop (std::size_t max_count, std::size_t max_bytes);
 		void clear ();
 		std::size_t size (nano::transport::traffic_type) const;
 		bool empty () const;
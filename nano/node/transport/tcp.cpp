@@ -6,6 +6,8 @@
 
 #include <boost/format.hpp>
 
+#include <cryptopp/words.h>
+
 /*
  * channel_tcp
  */
@@ -148,6 +150,7 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 			}
 			channels.get<endpoint_tag> ().emplace (channel_a, socket_a, server_a);
 			attempts.get<endpoint_tag> ().erase (endpoint);
+			publish_snapshot ();
 			error = false;
 			lock.unlock ();
 			node.network.channel_observer (channel_a);
@@ -159,23 +162,47 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 void nano::transport::tcp_channels::erase (nano::tcp_endpoint const & endpoint_a)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	if (channels.get<endpoint_tag> ().erase (endpoint_a) > 0)
+	{
+		publish_snapshot ();
+	}
+}
+
+void nano::transport::tcp_channels::publish_snapshot ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto result = std::make_shared<snapshot> ();
+	result->channels.reserve (channels.size ());
+	result->by_endpoint.reserve (channels.size ());
+	for (auto const & wrapper : channels.get<random_access_tag> ())
+	{
+		result->channels.push_back (wrapper.channel);
+		result->by_endpoint.emplace (wrapper.endpoint (), wrapper.channel);
+	}
+	std::shared_ptr<snapshot const> previous{ std::move (result) };
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	channels_snapshot.swap (previous);
+}
+
+auto nano::transport::tcp_channels::current_snapshot () const -> std::shared_ptr<snapshot const>
+{
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	return channels_snapshot;
 }
 
 std::size_t nano::transport::tcp_channels::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return channels.size ();
+	return current_snapshot ()->channels.size ();
 }
 
 std::shared_ptr<nano::transport::channel_tcp> nano::transport::tcp_channels::find_channel (nano::tcp_endpoint const & endpoint_a) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto snapshot_l = current_snapshot ();
 	std::shared_ptr<nano::transport::channel_tcp> result;
-	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
-	if (existing != channels.get<endpoint_tag> ().end ())
+	auto existing (snapshot_l->by_endpoint.find (endpoint_a));
+	if (existing != snapshot_l->by_endpoint.end ())
 	{
-		result = existing->channel;
+		result = existing->second;
 	}
 	return result;
 }
@@ -184,19 +211,20 @@ std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::t
 {
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
 	result.reserve (count_a);
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto snapshot_l = current_snapshot ();
+	auto const & channels_l = snapshot_l->channels;
 	// Stop trying to fill result with random samples after this many attempts
 	auto random_cutoff (count_a * 2);
-	auto peers_size (channels.size ());
+	auto peers_size (channels_l.size ());
 	// Usually count_a will be much smaller than peers.size()
 	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
+	if (!channels_l.empty ())
 	{
 		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
 		{
 			auto index (nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (peers_size - 1)));
 
-			auto channel = channels.get<random_access_tag> ()[index].channel;
+			auto const & channel = channels_l[index];
 			if (!channel->alive ())
 			{
 				continue;
@@ -376,6 +404,7 @@ void nano::transport::tcp_channels::stop ()
 		}
 	}
 	channels.clear ();
+	publish_snapshot ();
 }
 
 bool nano::transport::tcp_channels::max_ip_connections (nano::tcp_endpoint const & endpoint_a)
@@ -481,6 +510,8 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 	// Check if any tcp channels belonging to old protocol versions which may still be alive due to async operations
 	auto lower_bound = channels.get<version_tag> ().lower_bound (node.network_params.network.protocol_version_min);
 	channels.get<version_tag> ().erase (channels.get<version_tag> ().begin (), lower_bound);
+
+	publish_snapshot ();
 }
 
 void nano::transport::tcp_channels::ongoing_keepalive ()
@@ -514,11 +545,11 @@ void nano::transport::tcp_channels::ongoing_keepalive ()
 
 void nano::transport::tcp_channels::list (std::deque<std::shared_ptr<nano::transport::channel>> & deque_a, uint8_t minimum_version_a, bool include_temporary_channels_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto snapshot_l = current_snapshot ();
 	// clang-format off
-	nano::transform_if (channels.get<random_access_tag> ().begin (), channels.get<random_access_tag> ().end (), std::back_inserter (deque_a),
-		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a.channel->get_network_version () >= minimum_version_a && (include_temporary_channels_a || !channel_a.channel->temporary); },
-		[](auto const & channel) { return channel.channel; });
+	nano::transform_if (snapshot_l->channels.begin (), snapshot_l->channels.end (), std::back_inserter (deque_a),
+		[include_temporary_channels_a, minimum_version_a](auto const & channel_a) { return channel_a->get_network_version () >= minimum_version_a && (include_temporary_channels_a || !channel_a->temporary); },
+		[](auto const & channel_a) { return channel_a; });
 	// clang-format on
 }
 
@@ -11,6 +11,7 @@
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -221,6 +222,23 @@ namespace transport
 			{
 			}
 		};
+		/**
+		 * Immutable copy of the channel list, read without locking by the hot lookup and fanout paths.
+		 * Republished under the mutex every time a channel is added or removed.
+		 */
+		class snapshot final
+		{
+		public:
+			std::vector<std::shared_ptr<nano::transport::channel_tcp>> channels;
+			std::unordered_map<nano::tcp_endpoint, std::shared_ptr<nano::transport::channel_tcp>> by_endpoint;
+		};
+		/** Must be called with the mutex held after changing the channel set */
+		void publish_snapshot ();
+		std::shared_ptr<snapshot const> current_snapshot () const;
+		/** Only guards the snapshot pointer, readers copy it out and never take the channel mutex */
+		mutable nano::mutex snapshot_mutex;
+		std::shared_ptr<snapshot const> channels_snapshot{ std::make_shared<snapshot const> () };
+
 		mutable nano::mutex mutex;
 		// clang-format off
 		boost::multi_index_container<channel_tcp_wrapper,
@@ -501,7 +501,13 @@ void nano::transport::tcp_server::queue_realtime (std::unique_ptr<nano::message>
 	{
 		return;
 	}
-	node->network.tcp_message_manager.put_message (nano::tcp_message_item{ std::move (message), remote_endpoint, remote_node_id, socket });
+	nano::tcp_message_item item{ std::move (message), remote_endpoint, remote_node_id, socket };
+	bool dropped = node->network.tcp_message_manager.put_message (item);
+	if (dropped && item.message->type () == nano::message_type::publish)
+	{
+		// The block was never looked at, a copy from another peer must not be rejected as a duplicate
+		node->network.publish_filter.clear (static_cast<nano::publish const &> (*item.message).digest);
+	}
 }
 
 /*
@@ -80,6 +80,7 @@ private:
 	void received_message (std::unique_ptr<nano::message> message);
 	bool process_message (std::unique_ptr<nano::message> message);
 
+	/** Hands the message to the packet processing threads. It is dropped without further notice when the queue of this peer is full, the remote end is expected to resend what matters */
 	void queue_realtime (std::unique_ptr<nano::message> message);
 
 	bool to_bootstrap_connection ();
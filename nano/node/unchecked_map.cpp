@@ -1,3 +1,4 @@
+#include <nano/lib/blocks.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/stats.hpp>
 #include <nano/lib/stats_enums.hpp>
@@ -5,8 +6,11 @@
 #include <nano/lib/timer.hpp>
 #include <nano/node/unchecked_map.hpp>
 
-nano::unchecked_map::unchecked_map (unsigned const max_unchecked_blocks, nano::stats & stats, bool const & disable_delete) :
+#include <optional>
+
+nano::unchecked_map::unchecked_map (unsigned const max_unchecked_blocks, nano::stats & stats, bool const & disable_delete, std::size_t max_memory) :
 	max_unchecked_blocks{ max_unchecked_blocks },
+	max_memory{ max_memory },
 	stats{ stats },
 	disable_delete{ disable_delete },
 	thread{ [this] () { run (); } }
@@ -21,32 +25,77 @@ nano::unchecked_map::~unchecked_map ()
 
 void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::unchecked_info const & info)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
 	nano::unchecked_key key{ dependency, info.block->hash () };
-	entries.get<tag_root> ().insert ({ key, info });
+	auto & by_root = entries.get<tag_root> ();
+	if (auto existing = by_root.find (key); existing != by_root.end ())
+	{
+		// Already known, refresh its position so the most recently put entries are evicted last
+		by_root.modify (existing, [this] (entry & entry_a) { entry_a.sequence = next_sequence++; });
+	}
+	else
+	{
+		entries.insert ({ key, info, next_sequence++ });
+		entries_memory += entry_memory (info);
+	}
 
-	if (entries.size () > max_unchecked_blocks)
+	auto & by_sequence = entries.get<tag_sequenced> ();
+	while (!by_sequence.empty () && (entries.size () > max_unchecked_blocks || entries_memory > max_memory))
 	{
-		entries.get<tag_sequenced> ().pop_front ();
+		entries_memory -= entry_memory (by_sequence.begin ()->info);
+		by_sequence.erase (by_sequence.begin ());
 	}
 	stats.inc (nano::stat::type::unchecked, nano::stat::detail::put);
 }
 
 void nano::unchecked_map::for_each (std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.begin (), n = entries.end (); predicate () && i != n; ++i)
+	std::vector<entry> chunk;
+	std::optional<uint64_t> last;
+	while (true)
 	{
-		action (i->key, i->info);
+		chunk.clear ();
+		{
+			nano::lock_guard<nano::mutex> lock{ entries_mutex };
+			auto & sequenced = entries.get<tag_sequenced> ();
+			// Resume after the last visited position, which stays valid even if that entry was removed meanwhile
+			auto i = last ? sequenced.upper_bound (*last) : sequenced.begin ();
+			for (auto n = sequenced.end (); i != n && chunk.size () < for_each_chunk_size; ++i)
+			{
+				chunk.push_back (*i);
+			}
+		}
+		if (chunk.empty ())
+		{
+			return;
+		}
+		for (auto const & item : chunk)
+		{
+			if (!predicate ())
+			{
+				return;
+			}
+			action (item.key, item.info);
+		}
+		last = chunk.back ().sequence;
 	}
 }
 
 void nano::unchecked_map::for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.template get<tag_root> ().lower_bound (nano::unchecked_key{ dependency, 0 }), n = entries.template get<tag_root> ().end (); predicate () && i != n && i->key.key () == dependency.as_block_hash (); ++i)
+	std::vector<entry> matches;
+	{
+		nano::lock_guard<nano::mutex> lock{ entries_mutex };
+		auto [i, n] = entries.get<tag_dependency> ().equal_range (dependency.as_block_hash ());
+		matches.assign (i, n);
+	}
+	for (auto const & item : matches)
 	{
-		action (i->key, i->info);
+		if (!predicate ())
+		{
+			return;
+		}
+		action (item.key, item.info);
 	}
 }
 
@@ -61,29 +110,48 @@ std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::block_hash con
 
 bool nano::unchecked_map::exists (nano::unchecked_key const & key) const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
 	return entries.get<tag_root> ().count (key) != 0;
 }
 
 void nano::unchecked_map::del (nano::unchecked_key const & key)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	auto erased = entries.get<tag_root> ().erase (key);
-	debug_assert (erased);
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
+	auto & by_root = entries.get<tag_root> ();
+	auto existing = by_root.find (key);
+	debug_assert (existing != by_root.end ());
+	if (existing != by_root.end ())
+	{
+		entries_memory -= entry_memory (existing->info);
+		by_root.erase (existing);
+	}
 }
 
 void nano::unchecked_map::clear ()
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
 	entries.clear ();
+	entries_memory = 0;
 }
 
 std::size_t nano::unchecked_map::count () const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
 	return entries.size ();
 }
 
+std::size_t nano::unchecked_map::memory () const
+{
+	nano::lock_guard<nano::mutex> lock{ entries_mutex };
+	return entries_memory;
+}
+
+std::size_t nano::unchecked_map::entry_memory (nano::unchecked_info const & info)
+{
+	// Approximation: the entry, the decoded block, which is about its serialized size, and a pair of node pointers per index
+	return sizeof (entry) + nano::block::size (info.block->type ()) + 6 * sizeof (void *);
+}
+
 void nano::unchecked_map::stop ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
@@ -113,9 +181,32 @@ void nano::unchecked_map::trigger (nano::hash_or_account const & dependency)
 
 void nano::unchecked_map::process_queries (decltype (buffer) const & back_buffer)
 {
-	for (auto const & item : back_buffer)
+	// Release every entry depending on the whole batch of triggered dependencies under a single lock
+	std::deque<nano::unchecked_info> released;
+	{
+		nano::lock_guard<nano::mutex> lock{ entries_mutex };
+		auto & by_dependency = entries.get<tag_dependency> ();
+		for (auto const & item : back_buffer)
+		{
+			auto [i, n] = by_dependency.equal_range (item.hash);
+			for (auto j = i; j != n; ++j)
+			{
+				released.push_back (j->info);
+				if (!disable_delete)
+				{
+					entries_memory -= entry_memory (j->info);
+				}
+			}
+			if (!disable_delete)
+			{
+				by_dependency.erase (i, n);
+			}
+		}
+	}
+	if (!released.empty ())
 	{
-		query_impl (item.hash);
+		stats.add (nano::stat::type::unchecked, nano::stat::detail::satisfied, nano::stat::dir::in, released.size ());
+		satisfied.notify (released);
 	}
 }
 
@@ -145,29 +236,12 @@ void nano::unchecked_map::run ()
 	}
 }
 
-void nano::unchecked_map::query_impl (nano::block_hash const & hash)
-{
-	std::deque<nano::unchecked_key> delete_queue;
-	for_each (hash, [this, &delete_queue] (nano::unchecked_key const & key, nano::unchecked_info const & info) {
-		delete_queue.push_back (key);
-		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
-		satisfied.notify (info);
-	});
-	if (!disable_delete)
-	{
-		for (auto const & key : delete_queue)
-		{
-			del (key);
-		}
-	}
-}
-
 std::unique_ptr<nano::container_info_component> nano::unchecked_map::collect_container_info (const std::string & name)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", entries.size (), sizeof (decltype (entries)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", count (), sizeof (decltype (entries)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "memory", memory (), 1 }));
+	nano::lock_guard<nano::mutex> lock{ mutex };
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queries", buffer.size (), sizeof (decltype (buffer)::value_type) }));
 	return composite;
 }
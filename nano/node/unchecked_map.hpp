@@ -5,12 +5,13 @@
 #include <nano/lib/observer_set.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <deque>
 #include <thread>
 
 namespace mi = boost::multi_index;
@@ -19,10 +20,15 @@ namespace nano
 {
 class stats;
 
+/**
+ * Blocks waiting for a dependency (previous block, source block or epoch open account) to be processed.
+ * Entries are indexed by hash of their dependency and evicted least recently put first once the map exceeds either its entry count or its memory budget.
+ * Actions passed to `for_each` are invoked without holding the map lock, on copies taken in chunks.
+ */
 class unchecked_map
 {
 public:
-	unchecked_map (unsigned const max_unchecked_blocks, nano::stats &, bool const & do_delete);
+	unchecked_map (unsigned const max_unchecked_blocks, nano::stats &, bool const & do_delete, std::size_t max_memory = default_max_memory);
 	~unchecked_map ();
 
 	void put (nano::hash_or_account const & dependency, nano::unchecked_info const & info);
@@ -37,6 +43,10 @@ public:
 	std::size_t count () const;
 	void stop ();
 	void flush ();
+	/** Approximate memory used by entries in bytes */
+	std::size_t memory () const;
+
+	static std::size_t constexpr default_max_memory = 64 * 1024 * 1024;
 
 	/**
 	 * Trigger requested dependencies
@@ -44,11 +54,11 @@ public:
 	void trigger (nano::hash_or_account const & dependency);
 
 public: // Events
-	nano::observer_set<nano::unchecked_info const &> satisfied;
+	/** All entries released by a batch of triggered dependencies, in trigger order */
+	nano::observer_set<std::deque<nano::unchecked_info> const &> satisfied;
 
 private:
 	void run ();
-	void query_impl (nano::block_hash const & hash);
 
 private: // Dependencies
 	nano::stats & stats;
@@ -63,29 +73,56 @@ private:
 	nano::mutex mutex;
 	std::thread thread;
 	unsigned const max_unchecked_blocks;
+	std::size_t const max_memory;
 
 	void process_queries (decltype (buffer) const & back_buffer);
 
+	/** Number of entries copied per lock acquisition by `for_each` */
+	static std::size_t constexpr for_each_chunk_size = 256;
+
 private:
 	struct entry
 	{
 		nano::unchecked_key key;
 		nano::unchecked_info info;
+		/** Position in put order, refreshed when an existing entry is put again */
+		uint64_t sequence;
+
+		nano::block_hash const & dependency () const
+		{
+			return key.previous;
+		}
+	};
+
+	struct key_hash
+	{
+		std::size_t operator() (nano::unchecked_key const & key) const
+		{
+			return std::hash<nano::block_hash> () (key.previous) ^ std::hash<nano::block_hash> () (key.hash);
+		}
 	};
 
 	// clang-format off
 	class tag_sequenced {};
 	class tag_root {};
+	class tag_dependency {};
 
 	using ordered_unchecked = boost::multi_index_container<entry,
 		mi::indexed_by<
-			mi::sequenced<mi::tag<tag_sequenced>>,
-			mi::ordered_unique<mi::tag<tag_root>,
-				mi::member<entry, nano::unchecked_key, &entry::key>>>>;
+			mi::ordered_unique<mi::tag<tag_sequenced>,
+				mi::member<entry, uint64_t, &entry::sequence>>,
+			mi::hashed_unique<mi::tag<tag_root>,
+				mi::member<entry, nano::unchecked_key, &entry::key>, key_hash>,
+			mi::hashed_non_unique<mi::tag<tag_dependency>,
+				mi::const_mem_fun<entry, nano::block_hash const &, &entry::dependency>, std::hash<nano::block_hash>>>>;
 	// clang-format on
 	ordered_unchecked entries;
+	uint64_t next_sequence{ 0 };
+	std::size_t entries_memory{ 0 };
+
+	static std::size_t entry_memory (nano::unchecked_info const &);
 
-	mutable std::recursive_mutex entries_mutex;
+	mutable nano::mutex entries_mutex;
 
 public: // Container info
 	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name);
@@ -127,67 +127,84 @@ void nano::vote_cache::vote (const nano::block_hash & hash, const std::shared_pt
 	auto const timestamp = vote->timestamp ();
 	auto const rep_weight = rep_weight_query (representative);
 
-	nano::unique_lock<nano::mutex> lock{ mutex };
-
-	auto & cache_by_hash = cache.get<tag_hash> ();
-	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
+	auto & shard = shard_for (hash);
+	bool inserted = false;
 	{
-		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::update);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
-		cache_by_hash.modify (existing, [this, &representative, &timestamp, &rep_weight] (entry & ent) {
-			ent.vote (representative, timestamp, rep_weight, config.max_voters);
-		});
-	}
-	else
-	{
-		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::insert);
+		auto & cache_by_hash = shard.cache.get<tag_hash> ();
+		if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
+		{
+			stats.inc (nano::stat::type::vote_cache, nano::stat::detail::update);
 
-		entry cache_entry{ hash };
-		cache_entry.vote (representative, timestamp, rep_weight, config.max_voters);
+			bool updated = false;
+			cache_by_hash.modify (existing, [this, &representative, &timestamp, &rep_weight, &updated] (cached_entry & ent) {
+				updated = ent.value.vote (representative, timestamp, rep_weight, config.max_voters);
+			});
+			if (updated)
+			{
+				track (shard, existing->value);
+			}
+		}
+		else
+		{
+			stats.inc (nano::stat::type::vote_cache, nano::stat::detail::insert);
 
-		cache.get<tag_hash> ().insert (cache_entry);
+			cached_entry cache_entry{ next_sequence++, entry{ hash } };
+			cache_entry.value.vote (representative, timestamp, rep_weight, config.max_voters);
 
-		// When cache overflown remove the oldest entry
-		if (cache.size () > config.max_size)
-		{
-			cache.get<tag_sequenced> ().pop_front ();
+			auto const was_empty = shard.cache.empty ();
+			shard.cache.get<tag_sequenced> ().push_back (cache_entry);
+			track (shard, cache_entry.value);
+			if (was_empty)
+			{
+				update_front (shard);
+			}
+			++size_m;
+			inserted = true;
 		}
 	}
+
+	// When cache overflown remove the oldest entry
+	while (inserted && size_m > config.max_size)
+	{
+		erase_oldest ();
+	}
 }
 
 bool nano::vote_cache::empty () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return cache.empty ();
+	return size_m == 0;
 }
 
 std::size_t nano::vote_cache::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return cache.size ();
+	return size_m;
 }
 
 std::optional<nano::vote_cache::entry> nano::vote_cache::find (const nano::block_hash & hash) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
-	auto & cache_by_hash = cache.get<tag_hash> ();
+	auto & cache_by_hash = shard.cache.get<tag_hash> ();
 	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
 	{
-		return *existing;
+		return existing->value;
 	}
 	return {};
 }
 
 bool nano::vote_cache::erase (const nano::block_hash & hash)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
 	bool result = false;
-	auto & cache_by_hash = cache.get<tag_hash> ();
+	auto & cache_by_hash = shard.cache.get<tag_hash> ();
 	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
 	{
-		cache_by_hash.erase (existing);
+		erase_impl (shard, shard.cache.project<tag_sequenced> (existing));
 		result = true;
 	}
 	return result;
@@ -195,30 +212,47 @@ bool nano::vote_cache::erase (const nano::block_hash & hash)
 
 void nano::vote_cache::clear ()
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	cache.clear ();
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		size_m -= shard.cache.size ();
+		shard.cache.clear ();
+		shard.top.clear ();
+		shard.threshold = 0;
+		shard.overflowed = false;
+		update_front (shard);
+	}
 }
 
 std::vector<nano::vote_cache::top_entry> nano::vote_cache::top (const nano::uint128_t & min_tally)
 {
 	stats.inc (nano::stat::type::vote_cache, nano::stat::detail::top);
 
-	std::vector<top_entry> results;
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
-
 		if (cleanup_interval.elapsed ())
 		{
 			cleanup ();
 		}
+	}
+
+	std::vector<top_entry> results;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
-		for (auto & entry : cache.get<tag_tally> ())
+		// Untracked entries might qualify once enough tracked ones were removed, rescanning the shard is amortized over many removals
+		if (shard.overflowed && shard.top.size () < top_rebuild_size && shard.threshold >= min_tally)
+		{
+			rebuild_top (shard);
+		}
+		for (auto const & item : shard.top.get<tag_tally> ())
 		{
-			if (entry.tally () < min_tally)
+			if (item.tally < min_tally)
 			{
 				break;
 			}
-			results.push_back ({ entry.hash (), entry.tally (), entry.final_tally () });
+			results.push_back (item);
 		}
 	}
 
@@ -237,6 +271,121 @@ std::vector<nano::vote_cache::top_entry> nano::vote_cache::top (const nano::uint
 	return results;
 }
 
+auto nano::vote_cache::shard_for (nano::block_hash const & hash) -> shard &
+{
+	return shards[std::hash<nano::block_hash> () (hash) % shard_count];
+}
+
+auto nano::vote_cache::shard_for (nano::block_hash const & hash) const -> shard const &
+{
+	return shards[std::hash<nano::block_hash> () (hash) % shard_count];
+}
+
+void nano::vote_cache::track (shard & shard, entry const & entry)
+{
+	debug_assert (!shard.mutex.try_lock ());
+
+	top_entry const item{ entry.hash (), entry.tally (), entry.final_tally () };
+
+	auto & top_by_hash = shard.top.get<tag_hash> ();
+	if (auto existing = top_by_hash.find (item.hash); existing != top_by_hash.end ())
+	{
+		top_by_hash.replace (existing, item);
+		return;
+	}
+
+	if (shard.top.size () < top_capacity)
+	{
+		// Only start tracking if the entry cannot be outranked by an untracked one
+		if (!shard.overflowed || item.tally >= shard.threshold)
+		{
+			shard.top.insert (item);
+		}
+		return;
+	}
+
+	auto & top_by_tally = shard.top.get<tag_tally> ();
+	auto lowest = std::prev (top_by_tally.end ());
+	auto untracked_tally = item.tally;
+	if (item.tally > lowest->tally)
+	{
+		untracked_tally = lowest->tally;
+		top_by_tally.erase (lowest);
+		shard.top.insert (item);
+	}
+	shard.threshold = shard.overflowed ? std::max (shard.threshold, untracked_tally) : untracked_tally;
+	shard.overflowed = true;
+}
+
+void nano::vote_cache::erase_impl (shard & shard, ordered_cache::iterator existing)
+{
+	debug_assert (!shard.mutex.try_lock ());
+
+	shard.top.get<tag_hash> ().erase (existing->hash ());
+	auto const was_front = existing == shard.cache.begin ();
+	shard.cache.erase (existing);
+	--size_m;
+	if (was_front)
+	{
+		update_front (shard);
+	}
+}
+
+void nano::vote_cache::rebuild_top (shard & shard)
+{
+	debug_assert (!shard.mutex.try_lock ());
+
+	std::vector<top_entry> items;
+	items.reserve (shard.cache.size ());
+	for (auto const & item : shard.cache)
+	{
+		items.push_back ({ item.value.hash (), item.value.tally (), item.value.final_tally () });
+	}
+	auto const count = std::min (items.size (), top_capacity);
+	auto const by_tally = [] (top_entry const & a, top_entry const & b) { return a.tally > b.tally; };
+	std::nth_element (items.begin (), items.begin () + count, items.end (), by_tally);
+
+	shard.top.clear ();
+	shard.top.insert (items.begin (), items.begin () + count);
+	shard.overflowed = items.size () > count;
+	shard.threshold = shard.overflowed ? std::min_element (items.begin () + count, items.end (), by_tally)->tally : 0;
+}
+
+void nano::vote_cache::update_front (shard & shard)
+{
+	debug_assert (!shard.mutex.try_lock ());
+	shard.front_sequence = shard.cache.empty () ? std::numeric_limits<uint64_t>::max () : shard.cache.front ().sequence;
+}
+
+void nano::vote_cache::erase_oldest ()
+{
+	while (true)
+	{
+		auto oldest = shards.end ();
+		uint64_t oldest_sequence = std::numeric_limits<uint64_t>::max ();
+		for (auto it = shards.begin (), end = shards.end (); it != end; ++it)
+		{
+			auto const sequence = it->front_sequence.load ();
+			if (sequence < oldest_sequence)
+			{
+				oldest = it;
+				oldest_sequence = sequence;
+			}
+		}
+		if (oldest == shards.end ())
+		{
+			return;
+		}
+		nano::lock_guard<nano::mutex> lock{ oldest->mutex };
+		// Another thread may have changed this shard since its front was read
+		if (!oldest->cache.empty () && oldest->cache.front ().sequence == oldest_sequence)
+		{
+			erase_impl (*oldest, oldest->cache.begin ());
+			return;
+		}
+	}
+}
+
 void nano::vote_cache::cleanup ()
 {
 	debug_assert (!mutex.try_lock ());
@@ -245,24 +394,32 @@ void nano::vote_cache::cleanup ()
 
 	auto const cutoff = std::chrono::steady_clock::now () - config.age_cutoff;
 
-	auto it = cache.begin ();
-	while (it != cache.end ())
+	for (auto & shard : shards)
 	{
-		if (it->last_vote () < cutoff)
-		{
-			it = cache.erase (it);
-		}
-		else
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto it = shard.cache.begin ();
+		while (it != shard.cache.end ())
 		{
-			++it;
+			auto current = it++;
+			if (current->value.last_vote () < cutoff)
+			{
+				erase_impl (shard, current);
+			}
 		}
 	}
 }
 
 std::unique_ptr<nano::container_info_component> nano::vote_cache::collect_container_info (const std::string & name) const
 {
+	std::size_t top_count = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		top_count += shard.top.size ();
+	}
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "cache", size (), sizeof (ordered_cache::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "top", top_count, sizeof (ordered_top::value_type) }));
 	return composite;
 }
 
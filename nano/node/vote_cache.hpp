@@ -8,11 +8,15 @@
 
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
+#include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -41,6 +45,11 @@ public:
 	std::chrono::seconds age_cutoff{ 5 * 60 };
 };
 
+/**
+ * Votes for blocks that do not have an active election yet.
+ * Entries are spread over independently locked shards by block hash. Every shard tracks its highest tally entries incrementally
+ * as votes arrive so that `top ()` does not need to order or scan the whole cache.
+ */
 class vote_cache final
 {
 public:
@@ -141,7 +150,23 @@ private: // Dependencies
 	nano::stats & stats;
 
 private:
-	void cleanup ();
+	static std::size_t constexpr shard_count = 16;
+	/** Number of highest tally entries tracked by each shard */
+	static std::size_t constexpr top_capacity = 1024;
+	/** Tracked entries are only rebuilt from the whole shard once fewer than this many are left, the highest remaining ones are returned until then */
+	static std::size_t constexpr top_rebuild_size = top_capacity / 2;
+
+	struct cached_entry
+	{
+		/** Global insertion order, used to evict the oldest entry across all shards */
+		uint64_t sequence;
+		entry value;
+
+		nano::block_hash hash () const
+		{
+			return value.hash ();
+		}
+	};
 
 	// clang-format off
 	class tag_sequenced {};
@@ -150,18 +175,58 @@ private:
 	// clang-format on
 
 	// clang-format off
-	using ordered_cache = boost::multi_index_container<entry,
+	using ordered_cache = boost::multi_index_container<cached_entry,
 	mi::indexed_by<
 		mi::sequenced<mi::tag<tag_sequenced>>,
 		mi::hashed_unique<mi::tag<tag_hash>,
-			mi::const_mem_fun<entry, nano::block_hash, &entry::hash>>,
+			mi::const_mem_fun<cached_entry, nano::block_hash, &cached_entry::hash>>
+	>>;
+
+	using ordered_top = boost::multi_index_container<top_entry,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_hash>,
+			mi::member<top_entry, nano::block_hash, &top_entry::hash>>,
 		mi::ordered_non_unique<mi::tag<tag_tally>,
-			mi::const_mem_fun<entry, nano::uint128_t, &entry::tally>, std::greater<>> // DESC
+			mi::member<top_entry, nano::uint128_t, &top_entry::tally>, std::greater<>> // DESC
 	>>;
 	// clang-format on
-	ordered_cache cache;
 
+	class shard final
+	{
+	public:
+		ordered_cache cache;
+		/**
+		 * Highest tally entries of this shard. Every tracked entry has a tally at least as high as any untracked one,
+		 * tallies only grow so untracked entries are reconsidered whenever they receive a vote.
+		 */
+		ordered_top top;
+		/** Upper bound for the tally of untracked entries, only meaningful when `overflowed` is set */
+		nano::uint128_t threshold{ 0 };
+		/** Set when some entries are not tracked in `top` */
+		bool overflowed{ false };
+		/** Sequence of the oldest entry or max value when empty, read without holding the mutex */
+		std::atomic<uint64_t> front_sequence{ std::numeric_limits<uint64_t>::max () };
+		mutable nano::mutex mutex;
+	};
+
+	shard & shard_for (nano::block_hash const &);
+	shard const & shard_for (nano::block_hash const &) const;
+	/** Updates the tracked top entries after \p entry received a vote, must hold the shard mutex */
+	void track (shard &, entry const &);
+	/** Removes the entry from the cache and from the tracked top entries, must hold the shard mutex */
+	void erase_impl (shard &, ordered_cache::iterator);
+	/** Tracks the highest tally entries from scratch, used when too many tracked entries were removed */
+	void rebuild_top (shard &);
+	void update_front (shard &);
+	void erase_oldest ();
+	void cleanup ();
+
+	std::array<shard, shard_count> shards;
+	std::atomic<std::size_t> size_m{ 0 };
+	std::atomic<uint64_t> next_sequence{ 0 };
+
+	/** Protects cleanup_interval */
 	mutable nano::mutex mutex;
 	nano::interval cleanup_interval;
 };
-}
\ No newline at end of file
+}
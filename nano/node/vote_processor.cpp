@@ -1,21 +1,34 @@
 
 #include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/node/active_transactions.hpp>
 #include <nano/node/node_observers.hpp>
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/online_reps.hpp>
 #include <nano/node/repcrawler.hpp>
+#include <nano/node/signatures.hpp>
+#include <nano/node/transport/channel.hpp>
+#include <nano/node/transport/transport.hpp>
 #include <nano/node/vote_processor.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/ledger.hpp>
 
 #include <boost/format.hpp>
 
+#include <array>
 #include <chrono>
+#include <future>
 using namespace std::chrono_literals;
 
-nano::vote_processor::vote_processor (nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a) :
+nano::vote_processor::shard::shard (std::size_t max_votes_a) :
+	max_votes{ max_votes_a }
+{
+}
+
+nano::vote_processor::vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a) :
+	checker (checker_a),
 	active (active_a),
 	observers (observers_a),
 	stats (stats_a),
@@ -26,40 +39,47 @@ nano::vote_processor::vote_processor (nano::active_transactions & active_a, nano
 	ledger (ledger_a),
 	network_params (network_params_a),
 	max_votes (flags_a.vote_processor_capacity),
-	started (false),
-	stopped (false),
-	thread ([this] () {
-		nano::thread_role::set (nano::thread_role::name::vote_processing);
-		process_loop ();
-		nano::unique_lock<nano::mutex> lock{ mutex };
-		votes.clear ();
-		condition.notify_all ();
-	})
+	duplicate_filter (64 * 1024, stats_a, nano::stat::type::vote_filter)
+{
+	auto const shard_count = std::max (1u, config.vote_processor_threads);
+	// Capacity is split evenly between shards, rounding up so that a non-zero capacity never results in a shard unable to queue
+	auto const shard_max_votes = (max_votes + shard_count - 1) / shard_count;
+	for (auto i = 0u; i < shard_count; ++i)
+	{
+		shards.push_back (std::make_unique<shard> (shard_max_votes));
+	}
+	for (auto & shard_l : shards)
+	{
+		shard_l->thread = std::thread ([this, &shard = *shard_l] () {
+			nano::thread_role::set (nano::thread_role::name::vote_processing);
+			process_loop (shard);
+			nano::unique_lock<nano::mutex> lock{ shard.mutex };
+			shard.votes.clear ();
+			shard.condition.notify_all ();
+		});
+	}
+}
+
+auto nano::vote_processor::shard_for (nano::account const & representative) -> shard &
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	condition.wait (lock, [&started = started] { return started; });
+	// Account is a public key, its bytes are uniformly distributed
+	return *shards[representative.qwords[0] % shards.size ()];
 }
 
-void nano::vote_processor::process_loop ()
+void nano::vote_processor::process_loop (shard & shard)
 {
 	nano::timer<std::chrono::milliseconds> elapsed;
 	bool log_this_iteration;
 
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	started = true;
-
-	lock.unlock ();
-	condition.notify_all ();
-	lock.lock ();
-
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
 	while (!stopped)
 	{
-		if (!votes.empty ())
+		if (!shard.votes.empty ())
 		{
-			decltype (votes) votes_l;
-			votes_l.swap (votes);
+			decltype (shard.votes) votes_l;
+			votes_l.swap (shard.votes);
 			lock.unlock ();
-			condition.notify_all ();
+			shard.condition.notify_all ();
 
 			log_this_iteration = false;
 			// TODO: This is a temporary measure to prevent spamming the logs until we can implement a better solution
@@ -72,8 +92,20 @@ void nano::vote_processor::process_loop ()
 				log_this_iteration = true;
 				elapsed.restart ();
 			}
-			verify_votes (votes_l);
-			total_processed += votes_l.size ();
+			auto const count = votes_l.size ();
+			auto const digests = filter_duplicates (votes_l);
+			auto const codes = verify_votes (votes_l);
+			for (std::size_t i = 0; i < codes.size (); ++i)
+			{
+				// Only votes applied to an election stay in the filter, anything else may be needed again when rebroadcast
+				if (codes[i] != nano::vote_code::vote)
+				{
+					duplicate_filter.clear (digests[i]);
+				}
+			}
+			shard.processed += count;
+			total_processed += count;
+			stats.inc (nano::stat::type::vote_processor, nano::stat::detail::batch);
 
 			if (log_this_iteration && elapsed.stop () > std::chrono::milliseconds (100))
 			{
@@ -84,10 +116,11 @@ void nano::vote_processor::process_loop ()
 			}
 
 			lock.lock ();
+			shard.condition.notify_all ();
 		}
 		else
 		{
-			condition.wait (lock);
+			shard.condition.wait (lock);
 		}
 	}
 }
@@ -96,34 +129,37 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote_a, std
 {
 	debug_assert (channel_a != nullptr);
 	bool process (false);
-	nano::unique_lock<nano::mutex> lock{ mutex };
+	auto & shard = shard_for (vote_a->account);
+	nano::unique_lock<nano::mutex> lock{ shard.mutex };
 	if (!stopped)
 	{
+		auto const max_votes_l = shard.max_votes;
+		auto const size = shard.votes.size ();
 		// Level 0 (< 0.1%)
-		if (votes.size () < 6.0 / 9.0 * max_votes)
+		if (size < 6.0 / 9.0 * max_votes_l)
 		{
 			process = true;
 		}
 		// Level 1 (0.1-1%)
-		else if (votes.size () < 7.0 / 9.0 * max_votes)
+		else if (size < 7.0 / 9.0 * max_votes_l)
 		{
-			process = (representatives_1.find (vote_a->account) != representatives_1.end ());
+			process = (shard.representatives_1.find (vote_a->account) != shard.representatives_1.end ());
 		}
 		// Level 2 (1-5%)
-		else if (votes.size () < 8.0 / 9.0 * max_votes)
+		else if (size < 8.0 / 9.0 * max_votes_l)
 		{
-			process = (representatives_2.find (vote_a->account) != representatives_2.end ());
+			process = (shard.representatives_2.find (vote_a->account) != shard.representatives_2.end ());
 		}
 		// Level 3 (> 5%)
-		else if (votes.size () < max_votes)
+		else if (size < max_votes_l)
 		{
-			process = (representatives_3.find (vote_a->account) != representatives_3.end ());
+			process = (shard.representatives_3.find (vote_a->account) != shard.representatives_3.end ());
 		}
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
+			shard.votes.emplace_back (vote_a, channel_a);
 			lock.unlock ();
-			condition.notify_all ();
+			shard.condition.notify_all ();
 			// Lock no longer required
 		}
 		else
@@ -134,15 +170,88 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote_a, std
 	return !process;
 }
 
-void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
+std::vector<nano::uint128_t> nano::vote_processor::filter_duplicates (decltype (shard::votes) & votes_a)
+{
+	// Vote hash, representative and signature followed by the v6 address and port of the sending channel
+	using key_t = std::array<uint8_t, sizeof (nano::block_hash) + sizeof (nano::account) + sizeof (nano::signature) + 16 + sizeof (uint16_t)>;
+	std::vector<key_t> keys (votes_a.size ());
+	std::vector<std::pair<uint8_t const *, size_t>> messages;
+	messages.reserve (votes_a.size ());
+	for (std::size_t i = 0; i < votes_a.size (); ++i)
+	{
+		auto const & [vote, channel] = votes_a[i];
+		auto & key = keys[i];
+		auto const hash = vote->hash ();
+		auto const endpoint = nano::transport::map_endpoint_to_v6 (channel->get_endpoint ());
+		auto const address = endpoint.address ().to_v6 ().to_bytes ();
+		auto const port = endpoint.port ();
+		auto it = std::copy (hash.bytes.begin (), hash.bytes.end (), key.begin ());
+		it = std::copy (vote->account.bytes.begin (), vote->account.bytes.end (), it);
+		it = std::copy (vote->signature.bytes.begin (), vote->signature.bytes.end (), it);
+		it = std::copy (address.begin (), address.end (), it);
+		*it++ = static_cast<uint8_t> (port >> 8);
+		*it = static_cast<uint8_t> (port);
+		messages.emplace_back (key.data (), key.size ());
+	}
+	std::vector<nano::uint128_t> digests;
+	auto const existed = duplicate_filter.apply (messages, &digests);
+	decltype (shard::votes) unique;
+	std::vector<nano::uint128_t> unique_digests;
+	for (std::size_t i = 0; i < votes_a.size (); ++i)
+	{
+		if (!existed[i])
+		{
+			unique.push_back (std::move (votes_a[i]));
+			unique_digests.push_back (digests[i]);
+		}
+		else
+		{
+			stats.inc (nano::stat::type::vote, nano::stat::detail::vote_duplicate);
+		}
+	}
+	votes_a.swap (unique);
+	return unique_digests;
+}
+
+std::vector<nano::vote_code> nano::vote_processor::verify_votes (decltype (shard::votes) const & votes_a)
 {
-	for (auto const & vote : votes_a)
+	// Split into batches to spread verification over all signature checker threads
+	std::vector<int> verifications (votes_a.size (), 0);
+	std::vector<std::future<void>> pending;
+	for (std::size_t offset = 0; offset < votes_a.size (); offset += nano::signature_checker::batch_size)
 	{
-		if (!nano::validate_message (vote.first->account, vote.first->hash (), vote.first->signature))
+		auto const end = std::min (votes_a.size (), offset + nano::signature_checker::batch_size);
+		nano::signature_check_set set;
+		for (auto i = offset; i < end; ++i)
 		{
-			vote_blocking (vote.first, vote.second, true);
+			auto const & vote = votes_a[i].first;
+			set.add (vote->account, vote->hash (), vote->signature);
+		}
+		auto done = std::make_shared<std::promise<void>> ();
+		auto future = done->get_future ();
+		bool stopped_l = checker.add (std::move (set), [&verifications, offset, done] (nano::signature_check_set & set) {
+			std::copy (set.verifications.begin (), set.verifications.end (), verifications.begin () + offset);
+			done->set_value ();
+		});
+		if (stopped_l)
+		{
+			break;
+		}
+		pending.push_back (std::move (future));
+	}
+	for (auto & future : pending)
+	{
+		future.wait ();
+	}
+	std::vector<nano::vote_code> result (votes_a.size (), nano::vote_code::invalid);
+	for (std::size_t i = 0; i < votes_a.size (); ++i)
+	{
+		if (verifications[i] == 1)
+		{
+			result[i] = vote_blocking (votes_a[i].first, votes_a[i].second, true);
 		}
 	}
+	return result;
 }
 
 nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a, bool validated)
@@ -183,41 +292,51 @@ nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote>
 
 void nano::vote_processor::stop ()
 {
+	stopped = true;
+	for (auto & shard : shards)
 	{
-		nano::lock_guard<nano::mutex> lock{ mutex };
-		stopped = true;
+		{
+			nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		}
+		shard->condition.notify_all ();
 	}
-	condition.notify_all ();
-	if (thread.joinable ())
+	for (auto & shard : shards)
 	{
-		thread.join ();
+		nano::join_or_pass (shard->thread);
 	}
 }
 
 void nano::vote_processor::flush ()
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	auto const cutoff = total_processed.load (std::memory_order_relaxed) + votes.size ();
-	bool success = condition.wait_for (lock, 60s, [this, &cutoff] () {
-		return stopped || votes.empty () || total_processed.load (std::memory_order_relaxed) >= cutoff;
-	});
-	if (!success)
+	for (auto & shard : shards)
 	{
-		logger.error (nano::log::type::vote_processor, "Flush timeout");
-		debug_assert (false && "vote_processor::flush timeout while waiting for flush");
+		nano::unique_lock<nano::mutex> lock{ shard->mutex };
+		auto const cutoff = shard->processed.load (std::memory_order_relaxed) + shard->votes.size ();
+		bool success = shard->condition.wait_for (lock, 60s, [this, &shard, &cutoff] () {
+			return stopped || shard->votes.empty () || shard->processed.load (std::memory_order_relaxed) >= cutoff;
+		});
+		if (!success)
+		{
+			logger.error (nano::log::type::vote_processor, "Flush timeout");
+			debug_assert (false && "vote_processor::flush timeout while waiting for flush");
+		}
 	}
 }
 
 std::size_t nano::vote_processor::size ()
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return votes.size ();
+	std::size_t result = 0;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard->mutex };
+		result += shard->votes.size ();
+	}
+	return result;
 }
 
 bool nano::vote_processor::empty ()
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return votes.empty ();
+	return size () == 0;
 }
 
 bool nano::vote_processor::half_full ()
@@ -227,53 +346,64 @@ bool nano::vote_processor::half_full ()
 
 void nano::vote_processor::calculate_weights ()
 {
-	nano::unique_lock<nano::mutex> lock{ mutex };
-	if (!stopped)
+	if (stopped)
 	{
-		representatives_1.clear ();
-		representatives_2.clear ();
-		representatives_3.clear ();
-		auto supply (online_reps.trended ());
-		auto rep_amounts = ledger.cache.rep_weights.get_rep_amounts ();
-		for (auto const & rep_amount : rep_amounts)
+		return;
+	}
+	std::vector<std::array<std::unordered_set<nano::account>, 3>> levels (shards.size ());
+	auto supply (online_reps.trended ());
+	auto rep_amounts = ledger.cache.rep_weights.get_rep_amounts ();
+	for (auto const & rep_amount : *rep_amounts)
+	{
+		nano::account const & representative (rep_amount.first);
+		auto & shard_levels = levels[representative.qwords[0] % shards.size ()];
+		auto weight (ledger.weight (representative));
+		if (weight > supply / 1000) // 0.1% or above (level 1)
 		{
-			nano::account const & representative (rep_amount.first);
-			auto weight (ledger.weight (representative));
-			if (weight > supply / 1000) // 0.1% or above (level 1)
+			shard_levels[0].insert (representative);
+			if (weight > supply / 100) // 1% or above (level 2)
 			{
-				representatives_1.insert (representative);
-				if (weight > supply / 100) // 1% or above (level 2)
+				shard_levels[1].insert (representative);
+				if (weight > supply / 20) // 5% or above (level 3)
 				{
-					representatives_2.insert (representative);
-					if (weight > supply / 20) // 5% or above (level 3)
-					{
-						representatives_3.insert (representative);
-					}
+					shard_levels[2].insert (representative);
 				}
 			}
 		}
 	}
+	for (std::size_t i = 0; i < shards.size (); ++i)
+	{
+		auto & shard = *shards[i];
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		shard.representatives_1.swap (levels[i][0]);
+		shard.representatives_2.swap (levels[i][1]);
+		shard.representatives_3.swap (levels[i][2]);
+	}
 }
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (vote_processor & vote_processor, std::string const & name)
 {
-	std::size_t votes_count;
-	std::size_t representatives_1_count;
-	std::size_t representatives_2_count;
-	std::size_t representatives_3_count;
-
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (std::size_t i = 0; i < vote_processor.shards.size (); ++i)
 	{
-		nano::lock_guard<nano::mutex> guard{ vote_processor.mutex };
-		votes_count = vote_processor.votes.size ();
-		representatives_1_count = vote_processor.representatives_1.size ();
-		representatives_2_count = vote_processor.representatives_2.size ();
-		representatives_3_count = vote_processor.representatives_3.size ();
+		auto & shard = *vote_processor.shards[i];
+		std::size_t votes_count;
+		std::size_t representatives_1_count;
+		std::size_t representatives_2_count;
+		std::size_t representatives_3_count;
+		{
+			nano::lock_guard<nano::mutex> guard{ shard.mutex };
+			votes_count = shard.votes.size ();
+			representatives_1_count = shard.representatives_1.size ();
+			representatives_2_count = shard.representatives_2.size ();
+			representatives_3_count = shard.representatives_3.size ();
+		}
+		auto shard_composite = std::make_unique<container_info_composite> ("shard_" + std::to_string (i));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (shard.votes)::value_type) }));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (shard.representatives_1)::value_type) }));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (shard.representatives_2)::value_type) }));
+		shard_composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (shard.representatives_3)::value_type) }));
+		composite->add_component (std::move (shard_composite));
 	}
-
-	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
 	return composite;
 }
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
+#include <nano/secure/network_filter.hpp>
 
 #include <deque>
 #include <memory>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace nano
 {
@@ -33,16 +36,21 @@ namespace transport
 	class channel;
 }
 
+/**
+ * Votes are partitioned by representative account between shards, each with its own queue and processing thread.
+ * Votes of a single representative are always processed in arrival order.
+ */
 class vote_processor final
 {
 public:
-	vote_processor (nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger &, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
+	vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger &, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
 
 	/** Returns false if the vote was processed */
 	bool vote (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &);
 	/** Note: node.active.mutex lock is required */
 	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, bool = false);
-	void verify_votes (std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> const &);
+	/** Verifies vote signatures in batches on the signature checker and processes the valid votes in order, returns the result for each vote */
+	std::vector<nano::vote_code> verify_votes (std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> const &);
 	/** Function blocks until either the current queue size (a established flush boundary as it'll continue to increase)
 	 * is processed or the queue is empty (end condition or cutoff's guard, as it is positioned ahead) */
 	void flush ();
@@ -54,8 +62,32 @@ public:
 	std::atomic<uint64_t> total_processed{ 0 };
 
 private:
-	void process_loop ();
+	class shard final
+	{
+	public:
+		explicit shard (std::size_t max_votes);
 
+		std::size_t const max_votes;
+		std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+		/** Representatives levels for random early detection, only holds representatives belonging to this shard */
+		std::unordered_set<nano::account> representatives_1;
+		std::unordered_set<nano::account> representatives_2;
+		std::unordered_set<nano::account> representatives_3;
+		std::atomic<uint64_t> processed{ 0 };
+		nano::condition_variable condition;
+		nano::mutex mutex{ mutex_identifier (mutexes::vote_processor) };
+		std::thread thread;
+	};
+
+	void process_loop (shard &);
+	/**
+	 * Drops votes already received from the same channel, the same vote relayed by different peers is kept so the rep crawler still sees replies
+	 * @return filter digests of the remaining votes, in order
+	 */
+	std::vector<nano::uint128_t> filter_duplicates (decltype (shard::votes) &);
+	shard & shard_for (nano::account const &);
+
+	nano::signature_checker & checker;
 	nano::active_transactions & active;
 	nano::node_observers & observers;
 	nano::stats & stats;
@@ -66,16 +98,9 @@ private:
 	nano::ledger & ledger;
 	nano::network_params & network_params;
 	std::size_t const max_votes;
-	std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
-	/** Representatives levels for random early detection */
-	std::unordered_set<nano::account> representatives_1;
-	std::unordered_set<nano::account> representatives_2;
-	std::unordered_set<nano::account> representatives_3;
-	nano::condition_variable condition;
-	nano::mutex mutex{ mutex_identifier (mutexes::vote_processor) };
-	bool started;
-	bool stopped;
-	std::thread thread;
+	nano::network_filter duplicate_filter;
+	std::vector<std::unique_ptr<shard>> shards;
+	std::atomic<bool> stopped{ false };
 
 	friend std::unique_ptr<container_info_component> collect_container_info (vote_processor & vote_processor, std::string const & name);
 	friend class vote_processor_weights_Test;
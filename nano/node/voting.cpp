@@ -1,4 +1,5 @@
 #include <nano/lib/stats.hpp>
+#include <nano/lib/thread_pool.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/network.hpp>
 #include <nano/node/nodeconfig.hpp>
@@ -49,9 +50,25 @@ std::size_t nano::vote_spacing::size () const
 	return recent.size ();
 }
 
-bool nano::local_vote_history::consistency_check (nano::root const & root_a) const
+nano::local_vote_history::local_vote_history (nano::voting_constants const & constants) :
+	constants{ constants },
+	max_shard_size{ std::max<std::size_t> (1, constants.max_cache / shard_count) }
 {
-	auto & history_by_root (history.get<tag_root> ());
+}
+
+auto nano::local_vote_history::shard_for (nano::root const & root_a) -> shard &
+{
+	return shards[std::hash<nano::root>{}(root_a) % shard_count];
+}
+
+auto nano::local_vote_history::shard_for (nano::root const & root_a) const -> shard const &
+{
+	return shards[std::hash<nano::root>{}(root_a) % shard_count];
+}
+
+bool nano::local_vote_history::consistency_check (shard const & shard_a, nano::root const & root_a) const
+{
+	auto & history_by_root (shard_a.history.get<tag_root> ());
 	auto const range (history_by_root.equal_range (root_a));
 	// All cached votes for a root must be for the same hash, this is actively enforced in local_vote_history::add
 	auto consistent_same = std::all_of (range.first, range.second, [hash = range.first->hash] (auto const & info_a) { return info_a.hash == hash; });
@@ -67,10 +84,11 @@ bool nano::local_vote_history::consistency_check (nano::root const & root_a) con
 
 void nano::local_vote_history::add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a)
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	clean ();
+	auto & shard_l = shard_for (root_a);
+	nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
+	clean (shard_l);
 	auto add_vote (true);
-	auto & history_by_root (history.get<tag_root> ());
+	auto & history_by_root (shard_l.history.get<tag_root> ());
 	// Erase any vote that is not for this hash, or duplicate by account, and if new timestamp is higher
 	auto range (history_by_root.equal_range (root_a));
 	for (auto i (range.first); i != range.second;)
@@ -96,31 +114,34 @@ void nano::local_vote_history::add (nano::root const & root_a, nano::block_hash
 		(void)result;
 		debug_assert (result.second);
 	}
-	debug_assert (consistency_check (root_a));
+	debug_assert (consistency_check (shard_l, root_a));
 }
 
 void nano::local_vote_history::erase (nano::root const & root_a)
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	auto & history_by_root (history.get<tag_root> ());
+	auto & shard_l = shard_for (root_a);
+	nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
+	auto & history_by_root (shard_l.history.get<tag_root> ());
 	auto range (history_by_root.equal_range (root_a));
 	history_by_root.erase (range.first, range.second);
 }
 
 std::vector<std::shared_ptr<nano::vote>> nano::local_vote_history::votes (nano::root const & root_a) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto const & shard_l = shard_for (root_a);
+	nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
 	std::vector<std::shared_ptr<nano::vote>> result;
-	auto range (history.get<tag_root> ().equal_range (root_a));
+	auto range (shard_l.history.get<tag_root> ().equal_range (root_a));
 	std::transform (range.first, range.second, std::back_inserter (result), [] (auto const & entry) { return entry.vote; });
 	return result;
 }
 
 std::vector<std::shared_ptr<nano::vote>> nano::local_vote_history::votes (nano::root const & root_a, nano::block_hash const & hash_a, bool const is_final_a) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto const & shard_l = shard_for (root_a);
+	nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
 	std::vector<std::shared_ptr<nano::vote>> result;
-	auto range (history.get<tag_root> ().equal_range (root_a));
+	auto range (shard_l.history.get<tag_root> ().equal_range (root_a));
 	// clang-format off
 	nano::transform_if (range.first, range.second, std::back_inserter (result),
 		[&hash_a, is_final_a](auto const & entry) { return entry.hash == hash_a && (!is_final_a || entry.vote->timestamp () == std::numeric_limits<uint64_t>::max ()); },
@@ -131,15 +152,16 @@ std::vector<std::shared_ptr<nano::vote>> nano::local_vote_history::votes (nano::
 
 bool nano::local_vote_history::exists (nano::root const & root_a) const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return history.get<tag_root> ().find (root_a) != history.get<tag_root> ().end ();
+	auto const & shard_l = shard_for (root_a);
+	nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
+	return shard_l.history.get<tag_root> ().find (root_a) != shard_l.history.get<tag_root> ().end ();
 }
 
-void nano::local_vote_history::clean ()
+void nano::local_vote_history::clean (shard & shard_a)
 {
 	debug_assert (constants.max_cache > 0);
-	auto & history_by_sequence (history.get<tag_sequence> ());
-	while (history_by_sequence.size () > constants.max_cache)
+	auto & history_by_sequence (shard_a.history.get<tag_sequence> ());
+	while (history_by_sequence.size () > max_shard_size)
 	{
 		history_by_sequence.erase (history_by_sequence.begin ());
 	}
@@ -147,21 +169,26 @@ void nano::local_vote_history::clean ()
 
 std::size_t nano::local_vote_history::size () const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-	return history.size ();
+	std::size_t result = 0;
+	for (auto const & shard_l : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard_l.mutex };
+		result += shard_l.history.size ();
+	}
+	return result;
 }
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::local_vote_history & history, std::string const & name)
 {
 	std::size_t history_count = history.size ();
-	auto sizeof_element = sizeof (decltype (history.history)::value_type);
+	auto sizeof_element = sizeof (nano::local_vote_history::history_t::value_type);
 	auto composite = std::make_unique<container_info_composite> (name);
 	/* This does not currently loop over each element inside the cache to get the sizes of the votes inside history*/
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "history", history_count, sizeof_element }));
 	return composite;
 }
 
-nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::stats & stats_a, nano::logger & logger_a, bool is_final_a) :
+nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::thread_pool & workers_a, nano::stats & stats_a, nano::logger & logger_a, bool is_final_a) :
 	config (config_a),
 	ledger (ledger_a),
 	wallets (wallets_a),
@@ -169,6 +196,7 @@ nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::
 	history (history_a),
 	spacing{ config_a.network_params.voting.delay },
 	network (network_a),
+	workers (workers_a),
 	stats (stats_a),
 	logger (logger_a),
 	is_final (is_final_a),
@@ -184,26 +212,18 @@ nano::vote_generator::~vote_generator ()
 	stop ();
 }
 
-bool nano::vote_generator::should_vote (store::write_transaction const & transaction, nano::root const & root_a, nano::block_hash const & hash_a)
+std::shared_ptr<nano::block> nano::vote_generator::votable (store::transaction const & transaction, nano::root const & root_a, nano::block_hash const & hash_a)
 {
 	auto block = ledger.store.block.get (transaction, hash_a);
-	bool should_vote = false;
-	if (is_final)
-	{
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block) && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
-		debug_assert (block == nullptr || root_a == block->root ());
-	}
-	else
-	{
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block);
-	}
+	debug_assert (block == nullptr || root_a == block->root ());
+	bool const should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block);
 
 	logger.trace (nano::log::type::vote_generator, nano::log::detail::should_vote,
 	nano::log::arg{ "should_vote", should_vote },
 	nano::log::arg{ "block", block },
 	nano::log::arg{ "is_final", is_final });
 
-	return should_vote;
+	return should_vote ? block : nullptr;
 }
 
 void nano::vote_generator::start ()
@@ -238,18 +258,34 @@ void nano::vote_generator::add (const root & root, const block_hash & hash)
 void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 {
 	std::deque<candidate_t> candidates_new;
+	if (is_final)
 	{
+		// Final votes are recorded for the whole batch in a single write transaction
 		auto transaction = ledger.store.tx_begin_write ({ tables::final_votes });
 
 		for (auto & [root, hash] : batch)
 		{
-			if (should_vote (transaction, root, hash))
+			auto block = votable (transaction, root, hash);
+			if (block != nullptr && ledger.store.final_vote.put (transaction, block->qualified_root (), hash))
 			{
 				candidates_new.emplace_back (root, hash);
 			}
 		}
 		// Commit write transaction
 	}
+	else
+	{
+		// Non-final votes are not persisted, so there is no need to contend for the write lock
+		auto transaction = ledger.store.tx_begin_read ();
+
+		for (auto & [root, hash] : batch)
+		{
+			if (votable (transaction, root, hash) != nullptr)
+			{
+				candidates_new.emplace_back (root, hash);
+			}
+		}
+	}
 	if (!candidates_new.empty ())
 	{
 		nano::unique_lock<nano::mutex> lock{ mutex };
@@ -321,9 +357,9 @@ void nano::vote_generator::broadcast (nano::unique_lock<nano::mutex> & lock_a)
 	if (!hashes.empty ())
 	{
 		lock_a.unlock ();
-		vote (hashes, roots, [this] (auto const & vote_a) {
-			this->broadcast_action (vote_a);
-			this->stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts);
+		vote (hashes, roots, [this] (votes_t const & votes_a) {
+			this->broadcast_action (votes_a);
+			this->stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts, nano::stat::dir::in, votes_a.size ());
 		});
 		lock_a.lock ();
 	}
@@ -359,9 +395,12 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 		if (!hashes.empty ())
 		{
 			stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, hashes.size ());
-			vote (hashes, roots, [this, &channel = request_a.second] (std::shared_ptr<nano::vote> const & vote_a) {
-				this->reply_action (vote_a, channel);
-				this->stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
+			vote (hashes, roots, [this, &channel = request_a.second] (votes_t const & votes_a) {
+				for (auto const & vote_l : votes_a)
+				{
+					this->reply_action (vote_l, channel);
+				}
+				this->stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in, votes_a.size ());
 			});
 		}
 	}
@@ -369,15 +408,19 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 	lock_a.lock ();
 }
 
-void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
+void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (votes_t const &)> const & action_a)
 {
 	debug_assert (hashes_a.size () == roots_a.size ());
-	std::vector<std::shared_ptr<nano::vote>> votes_l;
-	wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-		auto timestamp = this->is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
-		uint8_t duration = this->is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
-		votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, duration, hashes_a));
+	// Keys are collected first so that signing happens outside of the wallet locks
+	std::vector<std::pair<nano::public_key, nano::raw_key>> representatives;
+	wallets.foreach_representative ([&representatives] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+		representatives.emplace_back (pub_a, prv_a);
 	});
+	if (representatives.empty ())
+	{
+		return;
+	}
+	auto votes_l = sign (representatives, hashes_a);
 	for (auto const & vote_l : votes_l)
 	{
 		for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
@@ -385,15 +428,78 @@ void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a,
 			history.add (roots_a[i], hashes_a[i], vote_l);
 			spacing.flag (roots_a[i], hashes_a[i]);
 		}
-		action_a (vote_l);
 	}
+	action_a (votes_l);
+}
+
+auto nano::vote_generator::sign (std::vector<std::pair<nano::public_key, nano::raw_key>> const & representatives_a, std::vector<nano::block_hash> const & hashes_a) -> votes_t
+{
+	class signing_state final
+	{
+	public:
+		signing_state (std::vector<std::pair<nano::public_key, nano::raw_key>> const & representatives_a, std::vector<nano::block_hash> const & hashes_a, uint64_t timestamp_a, uint8_t duration_a) :
+			representatives{ representatives_a },
+			hashes{ hashes_a },
+			timestamp{ timestamp_a },
+			duration{ duration_a },
+			count{ representatives_a.size () },
+			votes (representatives_a.size ())
+		{
+		}
+
+		/** Signs votes until none are left, safe to call from any number of threads */
+		void run ()
+		{
+			for (auto index = next++; index < count; index = next++)
+			{
+				auto const & [pub, prv] = representatives[index];
+				votes[index] = std::make_shared<nano::vote> (pub, prv, timestamp, duration, hashes);
+				if (++done == count)
+				{
+					nano::lock_guard<nano::mutex> guard{ mutex };
+					condition.notify_all ();
+				}
+			}
+		}
+
+		std::vector<std::pair<nano::public_key, nano::raw_key>> const representatives;
+		std::vector<nano::block_hash> const hashes;
+		uint64_t const timestamp;
+		uint8_t const duration;
+		std::size_t const count;
+		votes_t votes;
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<std::size_t> done{ 0 };
+		nano::mutex mutex;
+		nano::condition_variable condition;
+	};
+
+	auto const timestamp = is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
+	uint8_t const duration = is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
+	auto state = std::make_shared<signing_state> (representatives_a, hashes_a, timestamp, duration);
+	// The calling thread takes part in signing, so progress does not depend on the workers picking up the tasks
+	auto const helpers = std::min<std::size_t> (representatives_a.size () - 1, workers.get_num_threads ());
+	for (std::size_t i = 0; i < helpers; ++i)
+	{
+		workers.push_task ([state] () {
+			state->run ();
+		});
+	}
+	state->run ();
+	// Wait for votes claimed by the workers that are still being signed
+	nano::unique_lock<nano::mutex> lock{ state->mutex };
+	state->condition.wait (lock, [&state] () { return state->done == state->count; });
+	return std::move (state->votes);
 }
 
-void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a) const
+void nano::vote_generator::broadcast_action (votes_t const & votes_a) const
 {
-	network.flood_vote_pr (vote_a);
-	network.flood_vote (vote_a, 2.0f);
-	vote_processor.vote (vote_a, std::make_shared<nano::transport::inproc::channel> (network.node, network.node));
+	network.flood_votes (votes_a, 2.0f);
+	auto const inproc = std::make_shared<nano::transport::inproc::channel> (network.node, network.node);
+	for (auto const & vote_l : votes_a)
+	{
+		vote_processor.vote (vote_l, inproc);
+	}
 }
 
 void nano::vote_generator::run ()
@@ -14,6 +14,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
 #include <condition_variable>
 #include <deque>
 #include <thread>
@@ -26,6 +27,7 @@ class ledger;
 class network;
 class node_config;
 class stats;
+class thread_pool;
 class vote_processor;
 class wallets;
 namespace transport
@@ -63,6 +65,10 @@ public:
 	std::size_t size () const;
 };
 
+/**
+ * Cache of locally generated votes, looked up by root on every confirmation request.
+ * Split into shards by root, each with its own lock and a share of the capacity, so concurrent lookups for different roots do not contend.
+ */
 class local_vote_history final
 {
 	class local_vote final
@@ -80,10 +86,7 @@ class local_vote_history final
 	};
 
 public:
-	local_vote_history (nano::voting_constants const & constants) :
-		constants{ constants }
-	{
-	}
+	local_vote_history (nano::voting_constants const & constants);
 	void add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a);
 	void erase (nano::root const & root_a);
 
@@ -93,20 +96,32 @@ public:
 
 private:
 	// clang-format off
-	boost::multi_index_container<local_vote,
+	using history_t = boost::multi_index_container<local_vote,
 	mi::indexed_by<
 		mi::hashed_non_unique<mi::tag<class tag_root>,
 			mi::member<local_vote, nano::root, &local_vote::root>>,
-		mi::sequenced<mi::tag<class tag_sequence>>>>
-	history;
+		mi::sequenced<mi::tag<class tag_sequence>>>>;
 	// clang-format on
 
+	class shard final
+	{
+	public:
+		history_t history;
+		mutable nano::mutex mutex;
+	};
+
+	static std::size_t constexpr shard_count = 16;
+	std::array<shard, shard_count> shards;
+
 	nano::voting_constants const & constants;
-	void clean ();
+	/** Capacity of each shard, the total capacity is `constants.max_cache` */
+	std::size_t const max_shard_size;
+	shard & shard_for (nano::root const &);
+	shard const & shard_for (nano::root const &) const;
+	void clean (shard &);
 	std::vector<std::shared_ptr<nano::vote>> votes (nano::root const & root_a) const;
 	// Only used in Debug
-	bool consistency_check (nano::root const &) const;
-	mutable nano::mutex mutex;
+	bool consistency_check (shard const &, nano::root const &) const;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (local_vote_history & history, std::string const & name);
 	friend class local_vote_history_basic_Test;
@@ -120,9 +135,13 @@ private:
 	using candidate_t = std::pair<nano::root, nano::block_hash>;
 	using request_t = std::pair<std::vector<candidate_t>, std::shared_ptr<nano::transport::channel>>;
 	using queue_entry_t = std::pair<nano::root, nano::block_hash>;
+	using votes_t = std::vector<std::shared_ptr<nano::vote>>;
 
 public:
-	vote_generator (nano::node_config const &, nano::ledger &, nano::wallets &, nano::vote_processor &, nano::local_vote_history &, nano::network &, nano::stats &, nano::logger &, bool is_final);
+	/**
+	 * @param workers : used to sign votes in parallel when the node hosts several representatives
+	 */
+	vote_generator (nano::node_config const &, nano::ledger &, nano::wallets &, nano::vote_processor &, nano::local_vote_history &, nano::network &, nano::thread_pool & workers, nano::stats &, nano::logger &, bool is_final);
 	~vote_generator ();
 
 	/** Queue items for vote generation, or broadcast votes already in cache */
@@ -138,15 +157,17 @@ private:
 	void run ();
 	void broadcast (nano::unique_lock<nano::mutex> &);
 	void reply (nano::unique_lock<nano::mutex> &, request_t &&);
-	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
-	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
+	/** Generates one vote per local representative for the hashes, the action is called once with all of them */
+	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (votes_t const &)> const &);
+	/** Signs one vote per representative, spreading the signatures over the worker pool */
+	votes_t sign (std::vector<std::pair<nano::public_key, nano::raw_key>> const &, std::vector<nano::block_hash> const &);
+	void broadcast_action (votes_t const &) const;
 	void process_batch (std::deque<queue_entry_t> & batch);
 	/**
 	 * Check if block is eligible for vote generation
-	 * @param transaction : needs `tables::final_votes` lock
-	 * @return: Should vote
+	 * @return: The block if it should be voted for
 	 */
-	bool should_vote (store::write_transaction const &, nano::root const &, nano::block_hash const &);
+	std::shared_ptr<nano::block> votable (store::transaction const &, nano::root const &, nano::block_hash const &);
 
 private:
 	std::function<void (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
@@ -159,6 +180,7 @@ private: // Dependencies
 	nano::local_vote_history & history;
 	nano::vote_spacing spacing;
 	nano::network & network;
+	nano::thread_pool & workers;
 	nano::stats & stats;
 	nano::logger & logger;
 
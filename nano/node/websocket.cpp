@@ -76,8 +76,7 @@ nano::websocket::confirmation_options::confirmation_options (boost::property_tre
 			nano::account result_l{};
 			if (!result_l.decode_account (account_l.second.data ()))
 			{
-				// Do not insert the given raw data to keep old prefix support
-				accounts.insert (result_l.to_account ());
+				accounts.insert (result_l);
 			}
 			else
 			{
@@ -97,7 +96,8 @@ bool nano::websocket::confirmation_options::should_filter (nano::websocket::mess
 {
 	bool should_filter_conf_type_l (true);
 
-	auto type_text_l (message_a.contents.get<std::string> ("message.confirmation_type"));
+	auto const & filter_l (message_a.filter);
+	auto const & type_text_l (filter_l.type);
 	if (type_text_l == "active_quorum" && confirmation_types & type_active_quorum)
 	{
 		should_filter_conf_type_l = false;
@@ -112,29 +112,23 @@ bool nano::websocket::confirmation_options::should_filter (nano::websocket::mess
 	}
 
 	bool should_filter_account (has_account_filtering_options);
-	auto destination_opt_l (message_a.contents.get_optional<std::string> ("message.block.link_as_account"));
-	if (destination_opt_l)
+	if (filter_l.destination && should_filter_account)
 	{
-		auto source_text_l (message_a.contents.get<std::string> ("message.account"));
-		if (all_local_accounts)
+		debug_assert (filter_l.account);
+		auto const & source_l (*filter_l.account);
+		auto const & destination_l (*filter_l.destination);
+		if (accounts.find (source_l) != accounts.end () || accounts.find (destination_l) != accounts.end ())
+		{
+			should_filter_account = false;
+		}
+		else if (all_local_accounts)
 		{
 			auto transaction_l (wallets.tx_begin_read ());
-			nano::account source_l{};
-			nano::account destination_l{};
-			auto decode_source_ok_l (!source_l.decode_account (source_text_l));
-			auto decode_destination_ok_l (!destination_l.decode_account (destination_opt_l.get ()));
-			(void)decode_source_ok_l;
-			(void)decode_destination_ok_l;
-			debug_assert (decode_source_ok_l && decode_destination_ok_l);
 			if (wallets.exists (transaction_l, source_l) || wallets.exists (transaction_l, destination_l))
 			{
 				should_filter_account = false;
 			}
 		}
-		if (accounts.find (source_text_l) != accounts.end () || accounts.find (destination_opt_l.get ()) != accounts.end ())
-		{
-			should_filter_account = false;
-		}
 	}
 
 	return should_filter_conf_type_l || should_filter_account;
@@ -149,15 +143,13 @@ bool nano::websocket::confirmation_options::update (boost::property_tree::ptree
 			nano::account result_l{};
 			if (!result_l.decode_account (account_l.second.data ()))
 			{
-				// Re-encode to keep old prefix support
-				auto encoded_l (result_l.to_account ());
 				if (insert_a)
 				{
-					this->accounts.insert (encoded_l);
+					this->accounts.insert (result_l);
 				}
 				else
 				{
-					this->accounts.erase (encoded_l);
+					this->accounts.erase (result_l);
 				}
 			}
 			else
@@ -206,8 +198,7 @@ nano::websocket::vote_options::vote_options (boost::property_tree::ptree const &
 			nano::account result_l{};
 			if (!result_l.decode_account (representative_l.second.data ()))
 			{
-				// Do not insert the given raw data to keep old prefix support
-				representatives.insert (result_l.to_account ());
+				representatives.insert (result_l);
 			}
 			else
 			{
@@ -224,12 +215,12 @@ nano::websocket::vote_options::vote_options (boost::property_tree::ptree const &
 
 bool nano::websocket::vote_options::should_filter (nano::websocket::message const & message_a) const
 {
-	auto type (message_a.contents.get<std::string> ("message.type"));
+	auto const & filter_l (message_a.filter);
+	auto const & type (filter_l.type);
 	bool should_filter_l = (!include_replays && type == "replay") || (!include_indeterminate && type == "indeterminate");
 	if (!should_filter_l && !representatives.empty ())
 	{
-		auto representative_text_l (message_a.contents.get<std::string> ("message.account"));
-		if (representatives.find (representative_text_l) == representatives.end ())
+		if (!filter_l.account || representatives.find (*filter_l.account) == representatives.end ())
 		{
 			should_filter_l = true;
 		}
@@ -305,7 +296,7 @@ void nano::websocket::session::close ()
 	});
 }
 
-void nano::websocket::session::write (nano::websocket::message message_a)
+void nano::websocket::session::write (nano::websocket::message const & message_a)
 {
 	nano::unique_lock<nano::mutex> lk (subscriptions_mutex);
 	auto subscription (subscriptions.find (message_a.topic));
@@ -313,10 +304,11 @@ void nano::websocket::session::write (nano::websocket::message message_a)
 	{
 		lk.unlock ();
 		auto this_l (shared_from_this ());
+		auto buffer_l (message_a.serialized ());
 		boost::asio::post (ws.get_strand (),
-		[message_a, this_l] () {
+		[buffer_l = std::move (buffer_l), this_l] () {
 			bool write_in_progress = !this_l->send_queue.empty ();
-			this_l->send_queue.emplace_back (message_a);
+			this_l->send_queue.emplace_back (buffer_l);
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
@@ -327,10 +319,9 @@ void nano::websocket::session::write (nano::websocket::message message_a)
 
 void nano::websocket::session::write_queued_messages ()
 {
-	auto msg (send_queue.front ().to_string ());
 	auto this_l (shared_from_this ());
 
-	ws.async_write (nano::shared_const_buffer (msg),
+	ws.async_write (send_queue.front (),
 	[this_l] (boost::system::error_code ec, std::size_t bytes_transferred) {
 		this_l->send_queue.pop_front ();
 		if (!ec)
@@ -688,7 +679,7 @@ void nano::websocket::listener::broadcast_confirmation (std::shared_ptr<nano::bl
 	}
 }
 
-void nano::websocket::listener::broadcast (nano::websocket::message message_a)
+void nano::websocket::listener::broadcast (nano::websocket::message const & message_a)
 {
 	nano::lock_guard<nano::mutex> lk (sessions_mutex);
 	for (auto & weak_session : sessions)
@@ -764,6 +755,8 @@ nano::websocket::message nano::websocket::message_builder::block_confirmed (std:
 			break;
 	};
 	message_node_l.add ("confirmation_type", confirmation_type);
+	message_l.filter.type = confirmation_type;
+	message_l.filter.account = account_a;
 
 	if (options_a.get_include_election_info () || options_a.get_include_election_info_with_votes ())
 	{
@@ -801,6 +794,10 @@ nano::websocket::message nano::websocket::message_builder::block_confirmed (std:
 			block_node_l.add ("subtype", subtype);
 		}
 		message_node_l.add_child ("block", block_node_l);
+		if (block_a->type () == nano::block_type::state)
+		{
+			message_l.filter.destination = block_a->link ().as_account ();
+		}
 	}
 
 	if (options_a.get_include_sideband_info ())
@@ -843,6 +840,8 @@ nano::websocket::message nano::websocket::message_builder::vote_received (std::s
 			break;
 	}
 	vote_node_l.put ("type", vote_type);
+	message_l.filter.type = vote_type;
+	message_l.filter.account = vote_a->account;
 	message_l.contents.add_child ("message", vote_node_l);
 	return message_l;
 }
@@ -978,6 +977,15 @@ std::string nano::websocket::message::to_string () const
 	return ostream.str ();
 }
 
+nano::shared_const_buffer const & nano::websocket::message::serialized () const
+{
+	if (!buffer)
+	{
+		buffer = nano::shared_const_buffer (to_string ());
+	}
+	return *buffer;
+}
+
 /*
  * websocket_server
  */
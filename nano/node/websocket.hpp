@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/asio.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/work.hpp>
@@ -13,6 +14,7 @@
 
 #include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -76,8 +78,29 @@ namespace websocket
 		}
 
 		std::string to_string () const;
+		/**
+		 * Serialized contents, built on first use and shared by every session writing this message.
+		 * Not thread safe, a message is serialized by the thread broadcasting it and must not be modified afterwards.
+		 */
+		nano::shared_const_buffer const & serialized () const;
+
+		/** Fields subscription filters match on, extracted by the message builder so filtering does not search the contents for every session */
+		class filter_fields final
+		{
+		public:
+			/** Confirmation type for confirmations, vote type for votes */
+			std::string type;
+			std::optional<nano::account> account;
+			/** Destination of state blocks, only set when the block is included */
+			std::optional<nano::account> destination;
+		};
+
 		nano::websocket::topic topic;
 		boost::property_tree::ptree contents;
+		filter_fields filter;
+
+	private:
+		mutable std::optional<nano::shared_const_buffer> buffer;
 	};
 
 	/** Message builder. This is expanded with new builder functions are necessary. */
@@ -204,7 +227,7 @@ namespace websocket
 		bool has_account_filtering_options{ false };
 		bool all_local_accounts{ false };
 		uint8_t confirmation_types{ type_all };
-		std::unordered_set<std::string> accounts;
+		std::unordered_set<nano::account> accounts;
 	};
 
 	/**
@@ -225,7 +248,7 @@ namespace websocket
 		bool should_filter (message const & message_a) const override;
 
 	private:
-		std::unordered_set<std::string> representatives;
+		std::unordered_set<nano::account> representatives;
 		bool include_replays{ false };
 		bool include_indeterminate{ false };
 	};
@@ -254,8 +277,8 @@ namespace websocket
 		/** Read the next message. This implicitely handles incoming websocket pings. */
 		void read ();
 
-		/** Enqueue \p message_a for writing to the websockets */
-		void write (nano::websocket::message message_a);
+		/** Enqueue \p message_a for writing to the websockets. Sessions writing the same message share its serialized buffer. */
+		void write (nano::websocket::message const & message_a);
 
 	private:
 		/** The owning listener */
@@ -266,8 +289,8 @@ namespace websocket
 
 		/** Buffer for received messages */
 		boost::beast::multi_buffer read_buffer;
-		/** Outgoing messages. The send queue is protected by accessing it only through the strand */
-		std::deque<message> send_queue;
+		/** Serialized outgoing messages. The send queue is protected by accessing it only through the strand */
+		std::deque<nano::shared_const_buffer> send_queue;
 
 		/** Cache remote & local endpoints to make them available after the socket is closed */
 		socket_type::endpoint_type remote;
@@ -312,7 +335,7 @@ namespace websocket
 		void broadcast_confirmation (std::shared_ptr<nano::block> const & block_a, nano::account const & account_a, nano::amount const & amount_a, std::string const & subtype, nano::election_status const & election_status_a, std::vector<nano::vote_with_weight_info> const & election_votes_a);
 
 		/** Broadcast \p message to all session subscribing to the message topic. */
-		void broadcast (nano::websocket::message message_a);
+		void broadcast (nano::websocket::message const & message_a);
 
 		std::uint16_t listening_port ()
 		{
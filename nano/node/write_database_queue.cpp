@@ -1,7 +1,10 @@
 #include <nano/lib/config.hpp>
+#include <nano/lib/stats.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/write_database_queue.hpp>
 
+#include <magic_enum.hpp>
+
 #include <algorithm>
 
 nano::write_guard::write_guard (std::function<void ()> guard_finish_callback_a) :
@@ -50,19 +53,58 @@ void nano::write_guard::release ()
 	owns = false;
 }
 
-nano::write_database_queue::write_database_queue (bool use_noops_a) :
-	guard_finish_callback ([use_noops_a, &queue = queue, &mutex = mutex, &cv = cv] () {
-		if (!use_noops_a)
+nano::write_database_queue::write_database_queue (bool use_noops_a, nano::stats & stats_a) :
+	stats (stats_a),
+	guard_finish_callback ([this] () {
+		finish ();
+	}),
+	use_noops (use_noops_a)
+{
+}
+
+void nano::write_database_queue::finish ()
+{
+	if (use_noops)
+	{
+		return;
+	}
+	bool flush = false;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		if (group_flush)
 		{
+			++group_size;
+			// The finishing writer is still at the front of the queue
+			if (queue.size () == 1 || group_size >= max_group_size)
 			{
-				nano::lock_guard<nano::mutex> guard (mutex);
-				queue.pop_front ();
+				flush = true;
+				group_size = 0;
 			}
-			cv.notify_all ();
 		}
-	}),
-	use_noops (use_noops_a)
+	}
+	if (flush)
+	{
+		// Sync the whole group while still holding the turn, the next writer only starts once it is on disk
+		group_flush ();
+		stats.inc (nano::stat::type::write_queue, nano::stat::detail::flush);
+	}
+	if (group_defer)
+	{
+		group_defer (false);
+	}
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		queue.pop_front ();
+	}
+	cv.notify_all ();
+}
+
+void nano::write_database_queue::enable_group_commit (std::function<void ()> flush_a, std::function<void (bool)> defer_a)
 {
+	debug_assert (!use_noops);
+	nano::lock_guard<nano::mutex> guard (mutex);
+	group_flush = std::move (flush_a);
+	group_defer = std::move (defer_a);
 }
 
 nano::write_guard nano::write_database_queue::wait (nano::writer writer)
@@ -72,6 +114,7 @@ nano::write_guard nano::write_database_queue::wait (nano::writer writer)
 		return write_guard ([] {});
 	}
 
+	auto const start = std::chrono::steady_clock::now ();
 	nano::unique_lock<nano::mutex> lk (mutex);
 	// Add writer to the end of the queue if it's not already waiting
 	auto exists = std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
@@ -84,7 +127,16 @@ nano::write_guard nano::write_database_queue::wait (nano::writer writer)
 	{
 		cv.wait (lk);
 	}
+	auto defer = group_defer;
+	lk.unlock ();
+	if (defer)
+	{
+		defer (true);
+	}
 
+	auto const waited = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start);
+	stats.inc (nano::stat::type::write_queue, to_stat_detail (writer));
+	stats.add (nano::stat::type::write_queue_wait, to_stat_detail (writer), nano::stat::dir::in, waited.count ());
 	return write_guard (guard_finish_callback);
 }
 
@@ -113,6 +165,10 @@ bool nano::write_database_queue::process (nano::writer writer)
 		}
 
 		result = (queue.front () == writer);
+		if (result && group_defer)
+		{
+			group_defer (true);
+		}
 	}
 
 	if (!result)
@@ -127,3 +183,10 @@ nano::write_guard nano::write_database_queue::pop ()
 {
 	return write_guard (guard_finish_callback);
 }
+
+nano::stat::detail nano::to_stat_detail (nano::writer writer)
+{
+	auto value = magic_enum::enum_cast<nano::stat::detail> (magic_enum::enum_name (writer));
+	debug_assert (value);
+	return value.value_or (nano::stat::detail{});
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/locks.hpp>
+#include <nano/lib/stats_enums.hpp>
 
 #include <condition_variable>
 #include <deque>
@@ -8,6 +9,8 @@
 
 namespace nano
 {
+class stats;
+
 /** Distinct areas write locking is done, order is irrelevant */
 enum class writer
 {
@@ -37,7 +40,7 @@ private:
 class write_database_queue final
 {
 public:
-	write_database_queue (bool use_noops_a);
+	write_database_queue (bool use_noops_a, nano::stats &);
 	/** Blocks until we are at the head of the queue */
 	write_guard wait (nano::writer writer);
 
@@ -50,11 +53,32 @@ public:
 	/** Doesn't actually pop anything until the returned write_guard is out of scope */
 	write_guard pop ();
 
+	/**
+	 * Enables group commit, writers are expected to commit without syncing to disk.
+	 * \p flush_a is called once the queue runs empty or after `max_group_size` consecutive writers so that a whole group of commits shares a single sync
+	 * \p defer_a is called on the writer's thread with true when it gets its turn and with false once it finishes, commits outside of a turn must sync on their own
+	 */
+	void enable_group_commit (std::function<void ()> flush_a, std::function<void (bool)> defer_a = nullptr);
+
+	static std::size_t constexpr max_group_size = 32;
+
+private:
+	void finish ();
+
+private: // Dependencies
+	nano::stats & stats;
+
 private:
 	std::deque<nano::writer> queue;
 	nano::mutex mutex;
 	nano::condition_variable cv;
 	std::function<void ()> guard_finish_callback;
 	bool use_noops;
+	std::function<void ()> group_flush;
+	std::function<void (bool)> group_defer;
+	/** Number of writers that finished since the last group flush */
+	std::size_t group_size{ 0 };
 };
+
+nano::stat::detail to_stat_detail (nano::writer);
 }
@@ -347,6 +347,17 @@ nano::account const & nano::pending_key::key () const
 	return account;
 }
 
+nano::delegator_key::delegator_key (nano::account const & representative_a, nano::account const & account_a) :
+	representative (representative_a),
+	account (account_a)
+{
+}
+
+bool nano::delegator_key::operator== (nano::delegator_key const & other_a) const
+{
+	return representative == other_a.representative && account == other_a.account;
+}
+
 nano::unchecked_info::unchecked_info (std::shared_ptr<nano::block> const & block_a) :
 	block (block_a),
 	modified_m (nano::seconds_since_epoch ())
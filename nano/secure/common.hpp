@@ -149,6 +149,19 @@ public:
 	nano::block_hash hash{ 0 };
 };
 
+/**
+ * Entry of the index from representatives to the accounts delegating to them
+ */
+class delegator_key final
+{
+public:
+	delegator_key () = default;
+	delegator_key (nano::account const & representative, nano::account const & account);
+	bool operator== (nano::delegator_key const &) const;
+	nano::account representative{};
+	nano::account account{};
+};
+
 class endpoint_key final
 {
 public:
@@ -270,6 +283,16 @@ enum class process_result
 	block_position, // This block cannot follow the previous block
 	insufficient_work // Insufficient work for this block, even though it passed the minimal validation
 };
+/**
+ * Result of signature verification done outside of the ledger, allows `ledger::process` to skip repeating the check
+ */
+enum class signature_verification : uint8_t
+{
+	unknown = 0,
+	invalid = 1,
+	valid = 2,
+	valid_epoch = 3 // Valid for epoch blocks
+};
 class process_return final
 {
 public:
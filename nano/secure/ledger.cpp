@@ -10,6 +10,7 @@
 #include <nano/store/block.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
+#include <nano/store/delegator.hpp>
 #include <nano/store/final.hpp>
 #include <nano/store/frontier.hpp>
 #include <nano/store/online_weight.hpp>
@@ -192,7 +193,7 @@ public:
 class ledger_processor : public nano::mutable_block_visitor
 {
 public:
-	ledger_processor (nano::ledger &, nano::store::write_transaction const &);
+	ledger_processor (nano::ledger &, nano::store::write_transaction const &, nano::signature_verification = nano::signature_verification::unknown);
 	virtual ~ledger_processor () = default;
 	void send_block (nano::send_block &) override;
 	void receive_block (nano::receive_block &) override;
@@ -203,12 +204,20 @@ public:
 	void epoch_block_impl (nano::state_block &);
 	nano::ledger & ledger;
 	nano::store::write_transaction const & transaction;
+	nano::signature_verification verification;
 	nano::process_return result;
 
 private:
 	bool validate_epoch_block (nano::state_block const & block_a);
+	/** Returns true if the signature is invalid, skips the check if it was already verified outside of the ledger */
+	bool validate_signature (nano::account const & signer, nano::block_hash const & hash, nano::signature const & signature, nano::signature_verification const verified) const;
 };
 
+bool ledger_processor::validate_signature (nano::account const & signer, nano::block_hash const & hash, nano::signature const & signature, nano::signature_verification const verified) const
+{
+	return verification == verified ? false : validate_message (signer, hash, signature);
+}
+
 // Returns true if this block which has an epoch link is correctly formed.
 bool ledger_processor::validate_epoch_block (nano::state_block const & block_a)
 {
@@ -224,7 +233,7 @@ bool ledger_processor::validate_epoch_block (nano::state_block const & block_a)
 		else
 		{
 			// Check for possible regular state blocks with epoch link (send subtype)
-			if (validate_message (block_a.hashables.account, block_a.hash (), block_a.signature))
+			if (verification != nano::signature_verification::valid_epoch && validate_signature (block_a.hashables.account, block_a.hash (), block_a.signature, nano::signature_verification::valid))
 			{
 				// Is epoch block signed correctly
 				if (validate_message (ledger.epoch_signer (block_a.link ()), block_a.hash (), block_a.signature))
@@ -267,7 +276,7 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Unambiguous)
 	if (result.code == nano::process_result::progress)
 	{
-		result.code = validate_message (block_a.hashables.account, hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Unambiguous)
+		result.code = validate_signature (block_a.hashables.account, hash, block_a.signature, nano::signature_verification::valid) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Unambiguous)
 		if (result.code == nano::process_result::progress)
 		{
 			debug_assert (!validate_message (block_a.hashables.account, hash, block_a.signature));
@@ -387,7 +396,7 @@ void ledger_processor::epoch_block_impl (nano::state_block & block_a)
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Unambiguous)
 	if (result.code == nano::process_result::progress)
 	{
-		result.code = validate_message (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Unambiguous)
+		result.code = validate_signature (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature, nano::signature_verification::valid_epoch) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Unambiguous)
 		if (result.code == nano::process_result::progress)
 		{
 			debug_assert (!validate_message (ledger.epoch_signer (block_a.hashables.link), hash, block_a.signature));
@@ -473,7 +482,7 @@ void ledger_processor::change_block (nano::change_block & block_a)
 					auto info = ledger.account_info (transaction, account);
 					debug_assert (info);
 					debug_assert (info->head == block_a.hashables.previous);
-					result.code = validate_message (account, hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Malformed)
+					result.code = validate_signature (account, hash, block_a.signature, nano::signature_verification::valid) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Malformed)
 					if (result.code == nano::process_result::progress)
 					{
 						nano::block_details block_details (nano::epoch::epoch_0, false /* unused */, false /* unused */, false /* unused */);
@@ -516,7 +525,7 @@ void ledger_processor::send_block (nano::send_block & block_a)
 				result.code = account.is_zero () ? nano::process_result::fork : nano::process_result::progress;
 				if (result.code == nano::process_result::progress)
 				{
-					result.code = validate_message (account, hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Malformed)
+					result.code = validate_signature (account, hash, block_a.signature, nano::signature_verification::valid) ? nano::process_result::bad_signature : nano::process_result::progress; // Is this block signed correctly (Malformed)
 					if (result.code == nano::process_result::progress)
 					{
 						nano::block_details block_details (nano::epoch::epoch_0, false /* unused */, false /* unused */, false /* unused */);
@@ -567,7 +576,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 				result.code = account.is_zero () ? nano::process_result::gap_previous : nano::process_result::progress; // Have we seen the previous block? No entries for account at all (Harmless)
 				if (result.code == nano::process_result::progress)
 				{
-					result.code = validate_message (account, hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is the signature valid (Malformed)
+					result.code = validate_signature (account, hash, block_a.signature, nano::signature_verification::valid) ? nano::process_result::bad_signature : nano::process_result::progress; // Is the signature valid (Malformed)
 					if (result.code == nano::process_result::progress)
 					{
 						debug_assert (!validate_message (account, hash, block_a.signature));
@@ -631,7 +640,7 @@ void ledger_processor::open_block (nano::open_block & block_a)
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block already? (Harmless)
 	if (result.code == nano::process_result::progress)
 	{
-		result.code = validate_message (block_a.hashables.account, hash, block_a.signature) ? nano::process_result::bad_signature : nano::process_result::progress; // Is the signature valid (Malformed)
+		result.code = validate_signature (block_a.hashables.account, hash, block_a.signature, nano::signature_verification::valid) ? nano::process_result::bad_signature : nano::process_result::progress; // Is the signature valid (Malformed)
 		if (result.code == nano::process_result::progress)
 		{
 			debug_assert (!validate_message (block_a.hashables.account, hash, block_a.signature));
@@ -683,9 +692,10 @@ void ledger_processor::open_block (nano::open_block & block_a)
 	}
 }
 
-ledger_processor::ledger_processor (nano::ledger & ledger_a, nano::store::write_transaction const & transaction_a) :
+ledger_processor::ledger_processor (nano::ledger & ledger_a, nano::store::write_transaction const & transaction_a, nano::signature_verification verification_a) :
 	ledger (ledger_a),
-	transaction (transaction_a)
+	transaction (transaction_a),
+	verification (verification_a)
 {
 }
 
@@ -915,10 +925,10 @@ std::optional<nano::pending_info> nano::ledger::pending_info (store::transaction
 	return std::nullopt;
 }
 
-nano::process_return nano::ledger::process (store::write_transaction const & transaction_a, nano::block & block_a)
+nano::process_return nano::ledger::process (store::write_transaction const & transaction_a, nano::block & block_a, nano::signature_verification verification_a)
 {
 	debug_assert (!constants.work.validate_entry (block_a) || constants.genesis == nano::dev::genesis);
-	ledger_processor processor (*this, transaction_a);
+	ledger_processor processor (*this, transaction_a, verification_a);
 	block_a.visit (processor);
 	if (processor.result.code == nano::process_result::progress)
 	{
@@ -1095,6 +1105,12 @@ nano::uint128_t nano::ledger::weight (nano::account const & account_a)
 	return cache.rep_weights.representation_get (account_a);
 }
 
+uint64_t nano::ledger::weights_generation () const
+{
+	// Leaving bootstrap weights changes weights without writing them
+	return cache.rep_weights.generation () * 2 + (check_bootstrap_weights.load () ? 1 : 0);
+}
+
 // Rollback blocks until `block_a' doesn't exist or it tries to penetrate the confirmation height
 bool nano::ledger::rollback (store::write_transaction const & transaction_a, nano::block_hash const & block_a, std::vector<std::shared_ptr<nano::block>> & list_a)
 {
@@ -1400,10 +1416,25 @@ void nano::ledger::update_account (store::write_transaction const & transaction_
 			store.account.del (transaction_a, account_a);
 		}
 		store.account.put (transaction_a, account_a, new_a);
+		if (old_a.head.is_zero () || old_a.representative != new_a.representative)
+		{
+			if (!old_a.head.is_zero ())
+			{
+				store.delegator.del (transaction_a, nano::delegator_key{ old_a.representative, account_a });
+			}
+			store.delegator.put (transaction_a, nano::delegator_key{ new_a.representative, account_a });
+		}
 	}
 	else
 	{
 		debug_assert (!store.confirmation_height.exists (transaction_a, account_a));
+		// Rolling back an open block passes an empty old info, the representative is read from the stored entry
+		auto existing = store.account.get (transaction_a, account_a);
+		debug_assert (existing);
+		if (existing)
+		{
+			store.delegator.del (transaction_a, nano::delegator_key{ existing->representative, account_a });
+		}
 		store.account.del (transaction_a, account_a);
 		debug_assert (cache.account_count > 0);
 		--cache.account_count;
@@ -1607,8 +1638,9 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		[&rocksdb_store] (store::read_transaction const & /*unused*/, auto i, auto n) {
 			for (; i != n; ++i)
 			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::accounts }));
+				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::accounts, nano::tables::delegators }));
 				rocksdb_store->account.put (rocksdb_transaction, i->first, i->second);
+				rocksdb_store->delegator.put (rocksdb_transaction, nano::delegator_key{ i->second.representative, i->first });
 			}
 		});
 
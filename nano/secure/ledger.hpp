@@ -55,6 +55,8 @@ public:
 	nano::uint128_t account_balance (store::transaction const &, nano::account const &, bool = false);
 	nano::uint128_t account_receivable (store::transaction const &, nano::account const &, bool = false);
 	nano::uint128_t weight (nano::account const &);
+	/** Changes whenever `weight` may return a different value for any account */
+	uint64_t weights_generation () const;
 	std::shared_ptr<nano::block> successor (store::transaction const &, nano::qualified_root const &);
 	std::shared_ptr<nano::block> forked_block (store::transaction const &, nano::block const &);
 	std::shared_ptr<nano::block> head_block (store::transaction const &, nano::account const &);
@@ -73,7 +75,7 @@ public:
 	nano::block_hash block_source (store::transaction const &, nano::block const &);
 	std::pair<nano::block_hash, nano::block_hash> hash_root_random (store::transaction const &) const;
 	std::optional<nano::pending_info> pending_info (store::transaction const & transaction, nano::pending_key const & key) const;
-	nano::process_return process (store::write_transaction const &, nano::block &);
+	nano::process_return process (store::write_transaction const &, nano::block &, nano::signature_verification = nano::signature_verification::unknown);
 	bool rollback (store::write_transaction const &, nano::block_hash const &, std::vector<std::shared_ptr<nano::block>> &);
 	bool rollback (store::write_transaction const &, nano::block_hash const &);
 	void update_account (store::write_transaction const &, nano::account const &, nano::account_info const &, nano::account_info const &);
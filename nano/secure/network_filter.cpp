@@ -1,27 +1,31 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/locks.hpp>
+#include <nano/lib/stats.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/network_filter.hpp>
 
-nano::network_filter::network_filter (size_t size_a) :
+#include <algorithm>
+#include <numeric>
+
+nano::network_filter::network_filter (size_t size_a, nano::stats & stats_a, nano::stat::type stat_type_a) :
+	stats{ stats_a },
+	stat_type{ stat_type_a },
 	items (size_a, nano::uint128_t{ 0 })
 {
-	nano::random_pool::generate_block (key, key.size ());
+	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (key.data ()), sizeof (key));
 }
 
 bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a)
 {
 	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
+	auto index (index_of (digest));
 
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
+	bool existed;
 	{
-		// Replace likely old element with a new one
-		element = digest;
+		nano::lock_guard<nano::mutex> lock{ mutex_for (index) };
+		existed = insert (index, digest);
 	}
 	if (digest_a)
 	{
@@ -30,10 +34,47 @@ bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano:
 	return existed;
 }
 
+std::vector<bool> nano::network_filter::apply (std::vector<std::pair<uint8_t const *, size_t>> const & messages_a, std::vector<nano::uint128_t> * digests_a)
+{
+	std::vector<nano::uint128_t> digests;
+	std::vector<size_t> indices;
+	digests.reserve (messages_a.size ());
+	indices.reserve (messages_a.size ());
+	for (auto const & [bytes, count] : messages_a)
+	{
+		digests.push_back (hash (bytes, count));
+		indices.push_back (index_of (digests.back ()));
+	}
+
+	// Visit messages grouped by stripe, keeping the original order within a stripe so duplicates inside the batch are detected
+	std::vector<size_t> order (messages_a.size ());
+	std::iota (order.begin (), order.end (), 0);
+	std::stable_sort (order.begin (), order.end (), [&indices] (size_t lhs, size_t rhs) {
+		return indices[lhs] % stripe_count < indices[rhs] % stripe_count;
+	});
+
+	std::vector<bool> result (messages_a.size (), false);
+	for (auto it = order.begin (), end = order.end (); it != end;)
+	{
+		auto const stripe_index = indices[*it] % stripe_count;
+		nano::lock_guard<nano::mutex> lock{ stripes[stripe_index].mutex };
+		for (; it != end && indices[*it] % stripe_count == stripe_index; ++it)
+		{
+			result[*it] = insert (indices[*it], digests[*it]);
+		}
+	}
+	if (digests_a)
+	{
+		*digests_a = std::move (digests);
+	}
+	return result;
+}
+
 void nano::network_filter::clear (nano::uint128_t const & digest_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto & element (get_element (digest_a));
+	auto index (index_of (digest_a));
+	nano::lock_guard<nano::mutex> lock{ mutex_for (index) };
+	auto & element (items[index]);
 	if (element == digest_a)
 	{
 		element = nano::uint128_t{ 0 };
@@ -42,14 +83,9 @@ void nano::network_filter::clear (nano::uint128_t const & digest_a)
 
 void nano::network_filter::clear (std::vector<nano::uint128_t> const & digests_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = nano::uint128_t{ 0 };
-		}
+		clear (digest);
 	}
 }
 
@@ -66,8 +102,14 @@ void nano::network_filter::clear (OBJECT const & object_a)
 
 void nano::network_filter::clear ()
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	items.assign (items.size (), nano::uint128_t{ 0 });
+	for (size_t stripe_index = 0; stripe_index < stripe_count; ++stripe_index)
+	{
+		nano::lock_guard<nano::mutex> lock{ stripes[stripe_index].mutex };
+		for (auto index = stripe_index; index < items.size (); index += stripe_count)
+		{
+			items[index] = nano::uint128_t{ 0 };
+		}
+	}
 }
 
 template <typename OBJECT>
@@ -81,19 +123,121 @@ nano::uint128_t nano::network_filter::hash (OBJECT const & object_a) const
 	return hash (bytes.data (), bytes.size ());
 }
 
-nano::uint128_t & nano::network_filter::get_element (nano::uint128_t const & hash_a)
+size_t nano::network_filter::index_of (nano::uint128_t const & hash_a) const
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (items.size () > 0);
-	size_t index (hash_a % items.size ());
-	return items[index];
+	return static_cast<size_t> (hash_a % items.size ());
+}
+
+nano::mutex & nano::network_filter::mutex_for (size_t index_a)
+{
+	return stripes[index_a % stripe_count].mutex;
+}
+
+bool nano::network_filter::insert (size_t index_a, nano::uint128_t const & digest_a)
+{
+	debug_assert (!mutex_for (index_a).try_lock ());
+	auto & element (items[index_a]);
+	bool existed (element == digest_a);
+	if (existed)
+	{
+		stats.inc (stat_type, nano::stat::detail::hit);
+	}
+	else
+	{
+		stats.inc (stat_type, nano::stat::detail::miss);
+		if (element != 0)
+		{
+			// A different live digest maps to the same element and is evicted
+			stats.inc (stat_type, nano::stat::detail::collision);
+		}
+		// Replace likely old element with a new one
+		element = digest_a;
+	}
+	return existed;
+}
+
+namespace
+{
+uint64_t rotl (uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t load64_le (uint8_t const * bytes)
+{
+	uint64_t result{ 0 };
+	for (int i = 7; i >= 0; --i)
+	{
+		result = (result << 8) | bytes[i];
+	}
+	return result;
+}
+
+void sipround (uint64_t & v0, uint64_t & v1, uint64_t & v2, uint64_t & v3)
+{
+	v0 += v1;
+	v1 = rotl (v1, 13);
+	v1 ^= v0;
+	v0 = rotl (v0, 32);
+	v2 += v3;
+	v3 = rotl (v3, 16);
+	v3 ^= v2;
+	v0 += v3;
+	v3 = rotl (v3, 21);
+	v3 ^= v0;
+	v2 += v1;
+	v1 = rotl (v1, 17);
+	v1 ^= v2;
+	v2 = rotl (v2, 32);
+}
 }
 
 nano::uint128_t nano::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
 {
-	nano::uint128_union digest{ 0 };
-	siphash_t siphash (key, static_cast<unsigned int> (key.size ()));
-	siphash.CalculateDigest (digest.bytes.data (), bytes_a, count_a);
+	// SipHash 2/4 with 128 bit output, producing the same digest bytes as CryptoPP::SipHash<2, 4, true>
+	uint64_t v0 = 0x736f6d6570736575ULL ^ key[0];
+	uint64_t v1 = 0x646f72616e646f6dULL ^ key[1] ^ 0xee;
+	uint64_t v2 = 0x6c7967656e657261ULL ^ key[0];
+	uint64_t v3 = 0x7465646279746573ULL ^ key[1];
+
+	auto const end = bytes_a + (count_a & ~size_t{ 7 });
+	for (auto current = bytes_a; current != end; current += 8)
+	{
+		auto const m = load64_le (current);
+		v3 ^= m;
+		sipround (v0, v1, v2, v3);
+		sipround (v0, v1, v2, v3);
+		v0 ^= m;
+	}
+	uint64_t b = static_cast<uint64_t> (count_a) << 56;
+	for (size_t i = 0, n = count_a & 7; i < n; ++i)
+	{
+		b |= static_cast<uint64_t> (end[i]) << (8 * i);
+	}
+	v3 ^= b;
+	sipround (v0, v1, v2, v3);
+	sipround (v0, v1, v2, v3);
+	v0 ^= b;
+
+	nano::uint128_union digest;
+	v2 ^= 0xee;
+	for (int i = 0; i < 4; ++i)
+	{
+		sipround (v0, v1, v2, v3);
+	}
+	auto const low = v0 ^ v1 ^ v2 ^ v3;
+	v1 ^= 0xdd;
+	for (int i = 0; i < 4; ++i)
+	{
+		sipround (v0, v1, v2, v3);
+	}
+	auto const high = v0 ^ v1 ^ v2 ^ v3;
+	for (int i = 0; i < 8; ++i)
+	{
+		digest.bytes[i] = static_cast<uint8_t> (low >> (8 * i));
+		digest.bytes[8 + i] = static_cast<uint8_t> (high >> (8 * i));
+	}
 	return digest.number ();
 }
 
@@ -1,24 +1,30 @@
 
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/stats_enums.hpp>
 
-#include <cryptopp/seckey.h>
-#include <cryptopp/siphash.h>
+#include <array>
+#include <utility>
+#include <vector>
 
 namespace nano
 {
+class stats;
+
 /**
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
  * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
+ * Elements are guarded by striped mutexes so that concurrent network threads rarely contend on the same lock.
  * @note This class is thread-safe.
  */
 class network_filter final
 {
 public:
 	network_filter () = delete;
-	network_filter (size_t size_a);
+	network_filter (size_t size_a, nano::stats &, nano::stat::type stat_type = nano::stat::type::filter);
 	/**
 	 * Reads \p count_a bytes starting from \p bytes_a and inserts the siphash digest in the filter.
 	 * @param \p digest_a if given, will be set to the resulting siphash digest
@@ -27,6 +33,14 @@ public:
 	 **/
 	bool apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a = nullptr);
 
+	/**
+	 * Applies every ( bytes, count ) range in \p messages_a , equivalent to calling apply on each of them in order.
+	 * Digests are computed up front and every stripe is locked at most once for the whole batch.
+	 * @param \p digests_a if given, will be set to the resulting siphash digests
+	 * @return the previous existence of each hash in the filter, in the same order as \p messages_a
+	 **/
+	std::vector<bool> apply (std::vector<std::pair<uint8_t const *, size_t>> const & messages_a, std::vector<nano::uint128_t> * digests_a = nullptr);
+
 	/**
 	 * Sets the corresponding element in the filter to zero, if it matches \p digest_a exactly.
 	 **/
@@ -61,23 +75,40 @@ public:
 	nano::uint128_t hash (OBJECT const & object_a) const;
 
 private:
-	using siphash_t = CryptoPP::SipHash<2, 4, true>;
+	static size_t constexpr stripe_count = 64;
+
+	class alignas (64) stripe final
+	{
+	public:
+		nano::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+	};
+
+	size_t index_of (nano::uint128_t const & hash_a) const;
+	nano::mutex & mutex_for (size_t index_a);
 
 	/**
-	 * Get element from digest.
-	 * @note must have a lock on mutex
-	 * @return a reference to the element with key \p hash_a
+	 * Inserts \p digest_a in the element at \p index_a
+	 * @note must have a lock on the stripe mutex for \p index_a
+	 * @return a boolean representing the previous existence of the hash in the filter.
 	 **/
-	nano::uint128_t & get_element (nano::uint128_t const & hash_a);
+	bool insert (size_t index_a, nano::uint128_t const & digest_a);
 
 	/**
 	 * Hashes \p count_a bytes starting from \p bytes_a .
+	 * Keyed SipHash 2/4/128 computed on the stack, without constructing a hash object or allocating per call.
 	 * @return the siphash digest of the contents in \p bytes_a .
 	 **/
 	nano::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
 
+private: // Dependencies
+	nano::stats & stats;
+	nano::stat::type const stat_type;
+
+private:
 	std::vector<nano::uint128_t> items;
-	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	nano::mutex mutex{ mutex_identifier (mutexes::network_filter) };
+	std::array<uint64_t, 2> key;
+	std::array<stripe, stripe_count> stripes;
+
+	friend class network_filter_siphash_Test;
 };
 }
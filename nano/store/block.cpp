@@ -1 +1,15 @@
 #include <nano/store/block.hpp>
+
+#include <algorithm>
+
+nano::block_hash nano::store::block::append_serialized (uint8_t const * data, std::size_t size, std::vector<uint8_t> & buffer)
+{
+	// The block type is the first byte and the sideband, which starts with the successor, follows the block
+	auto type = static_cast<nano::block_type> (data[0]);
+	debug_assert (size > nano::block_sideband::size (type));
+	auto successor_offset = size - nano::block_sideband::size (type);
+	buffer.insert (buffer.end (), data, data + successor_offset);
+	nano::block_hash result;
+	std::copy_n (data + successor_offset, result.bytes.size (), result.bytes.begin ());
+	return result;
+}
@@ -2,10 +2,13 @@
 
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/store/block_cache.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/iterator.hpp>
 
 #include <functional>
+#include <optional>
+#include <vector>
 
 namespace nano
 {
@@ -30,6 +33,11 @@ public:
 	virtual nano::block_hash successor (store::transaction const &, nano::block_hash const &) const = 0;
 	virtual void successor_clear (store::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> get (store::transaction const &, nano::block_hash const &) const = 0;
+	/**
+	 * Appends the block in its network serialization (block type and block, without sideband) to \p buffer, copied straight from the stored value
+	 * @return successor of the block, or nullopt if the block does not exist
+	 */
+	virtual std::optional<nano::block_hash> get_serialized (store::transaction const &, nano::block_hash const &, std::vector<uint8_t> & buffer) const = 0;
 	virtual std::shared_ptr<nano::block> random (store::transaction const &) = 0;
 	virtual void del (store::write_transaction const &, nano::block_hash const &) = 0;
 	virtual bool exists (store::transaction const &, nano::block_hash const &) = 0;
@@ -38,5 +46,15 @@ public:
 	virtual iterator<nano::block_hash, block_w_sideband> begin (store::transaction const &) const = 0;
 	virtual iterator<nano::block_hash, block_w_sideband> end () const = 0;
 	virtual void for_each_par (std::function<void (store::read_transaction const &, iterator<nano::block_hash, block_w_sideband>, iterator<nano::block_hash, block_w_sideband>)> const & action_a) const = 0;
+
+	/** Decoded blocks returned by `get` */
+	mutable nano::store::block_cache cache;
+
+protected:
+	/**
+	 * Appends the network serialization of a raw stored block value (block followed by sideband) to \p buffer
+	 * @return successor read from the start of the sideband
+	 */
+	static nano::block_hash append_serialized (uint8_t const * data, std::size_t size, std::vector<uint8_t> & buffer);
 };
 } // namespace nano::store
@@ -0,0 +1,156 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/store/block_cache.hpp>
+
+#include <algorithm>
+
+nano::store::block_cache::block_cache (std::size_t max_memory) :
+	max_shard_memory{ max_memory / shard_count }
+{
+}
+
+void nano::store::block_cache::attach (nano::stats & stats_a)
+{
+	stats = &stats_a;
+}
+
+void nano::store::block_cache::set_max_memory (std::size_t max_memory)
+{
+	max_shard_memory = max_memory / shard_count;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		evict (shard, max_shard_memory);
+	}
+}
+
+std::shared_ptr<nano::block> nano::store::block_cache::get (nano::block_hash const & hash, uint8_t const * data, std::size_t size)
+{
+	std::shared_ptr<nano::block> existing_block;
+	{
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		if (auto existing = shard.index.find (hash); existing != shard.index.end ())
+		{
+			auto & entry = *existing->second;
+			// The successor in the sideband changes and rolled back blocks can be inserted again, only identical values are safe to share
+			if (entry.raw.size () == size && std::equal (entry.raw.begin (), entry.raw.end (), data))
+			{
+				shard.entries.splice (shard.entries.begin (), shard.entries, existing->second);
+				existing_block = entry.block;
+			}
+		}
+	}
+	if (auto stats_l = stats.load ())
+	{
+		stats_l->inc (nano::stat::type::block_cache, existing_block ? nano::stat::detail::hit : nano::stat::detail::miss);
+	}
+	return existing_block;
+}
+
+void nano::store::block_cache::put (nano::block_hash const & hash, uint8_t const * data, std::size_t size, std::shared_ptr<nano::block> const & block)
+{
+	auto const max_memory = max_shard_memory.load ();
+	if (max_memory == 0)
+	{
+		return;
+	}
+	debug_assert (block != nullptr);
+	// Cache the hash now, cached blocks are shared between threads
+	block->hash ();
+
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	if (auto existing = shard.index.find (hash); existing != shard.index.end ())
+	{
+		erase_impl (shard, existing->second);
+	}
+	shard.entries.push_front ({ hash, std::vector<uint8_t> (data, data + size), block });
+	shard.index.emplace (hash, shard.entries.begin ());
+	shard.memory += entry_memory (size);
+	evict (shard, max_memory);
+}
+
+void nano::store::block_cache::erase (nano::block_hash const & hash)
+{
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	if (auto existing = shard.index.find (hash); existing != shard.index.end ())
+	{
+		erase_impl (shard, existing->second);
+	}
+}
+
+void nano::store::block_cache::clear ()
+{
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.entries.clear ();
+		shard.index.clear ();
+		shard.memory = 0;
+	}
+}
+
+std::size_t nano::store::block_cache::size () const
+{
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		result += shard.entries.size ();
+	}
+	return result;
+}
+
+std::size_t nano::store::block_cache::memory () const
+{
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		result += shard.memory;
+	}
+	return result;
+}
+
+std::size_t nano::store::block_cache::max_blocks () const
+{
+	return max_shard_memory.load () * shard_count / entry_memory (nano::state_block::size + nano::block_sideband::size (nano::block_type::state));
+}
+
+auto nano::store::block_cache::shard_for (nano::block_hash const & hash) -> shard &
+{
+	return shards[std::hash<nano::block_hash> () (hash) % shard_count];
+}
+
+void nano::store::block_cache::erase_impl (shard & shard, std::list<entry>::iterator existing)
+{
+	debug_assert (!shard.mutex.try_lock ());
+	shard.memory -= entry_memory (existing->raw.size ());
+	shard.index.erase (existing->hash);
+	shard.entries.erase (existing);
+}
+
+void nano::store::block_cache::evict (shard & shard, std::size_t max_memory)
+{
+	debug_assert (!shard.mutex.try_lock ());
+	while (shard.memory > max_memory && !shard.entries.empty ())
+	{
+		erase_impl (shard, std::prev (shard.entries.end ()));
+	}
+}
+
+std::size_t nano::store::block_cache::entry_memory (std::size_t raw_size)
+{
+	// Raw value plus the decoded block, which is about the same size, and the list and index nodes
+	return sizeof (entry) + 2 * raw_size + sizeof (std::pair<nano::block_hash, std::list<entry>::iterator>) + 4 * sizeof (void *);
+}
+
+std::unique_ptr<nano::container_info_component> nano::store::collect_container_info (block_cache & cache, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", cache.size (), sizeof (block_cache::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "memory", cache.memory (), 1 }));
+	return composite;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace nano
+{
+class block;
+class stats;
+}
+
+namespace nano::store
+{
+/**
+ * Decoded blocks kept in front of the block table so that hot blocks are not deserialized on every read.
+ * Entries remember the raw value they were decoded from and are only returned when the value read in the
+ * caller's transaction is identical, so the cache never has to track transaction snapshots, successor updates or rollbacks.
+ * Entries are spread over independently locked shards, each evicting least recently used entries to stay within its share of the memory budget.
+ * Cached blocks are handed out directly and shared by every reader, blocks read from the store must be treated as immutable.
+ */
+class block_cache final
+{
+public:
+	explicit block_cache (std::size_t max_memory = default_max_memory);
+
+	/** Reports hits and misses to \p stats */
+	void attach (nano::stats &);
+	/** Changes the memory budget, evicting entries if the cache is over the new budget */
+	void set_max_memory (std::size_t max_memory);
+
+	/** @return the cached block if it was decoded from exactly [ \p data, \p data + \p size ), nullptr otherwise */
+	std::shared_ptr<nano::block> get (nano::block_hash const &, uint8_t const * data, std::size_t size);
+	/** Caches \p block decoded from [ \p data, \p data + \p size ), the block is shared with later readers and must not be modified afterwards */
+	void put (nano::block_hash const &, uint8_t const * data, std::size_t size, std::shared_ptr<nano::block> const & block);
+	void erase (nano::block_hash const &);
+	void clear ();
+
+	std::size_t size () const;
+	/** Approximate memory used by cached entries in bytes */
+	std::size_t memory () const;
+	/** Approximate number of state blocks fitting in the memory budget */
+	std::size_t max_blocks () const;
+
+	static std::size_t constexpr default_max_memory = 64 * 1024 * 1024;
+
+private:
+	class entry final
+	{
+	public:
+		nano::block_hash hash;
+		std::vector<uint8_t> raw;
+		std::shared_ptr<nano::block> block;
+	};
+
+	class shard final
+	{
+	public:
+		/** Most recently used entries at the front */
+		std::list<entry> entries;
+		std::unordered_map<nano::block_hash, std::list<entry>::iterator> index;
+		std::size_t memory{ 0 };
+		mutable nano::mutex mutex;
+	};
+
+	shard & shard_for (nano::block_hash const &);
+	void erase_impl (shard &, std::list<entry>::iterator);
+	void evict (shard &, std::size_t max_memory);
+	static std::size_t entry_memory (std::size_t raw_size);
+
+	static std::size_t constexpr shard_count = 16;
+
+	std::atomic<std::size_t> max_shard_memory;
+	std::array<shard, shard_count> shards;
+	std::atomic<nano::stats *> stats{ nullptr };
+
+	friend std::unique_ptr<container_info_component> collect_container_info (block_cache &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (block_cache &, std::string const & name);
+}
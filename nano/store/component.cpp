@@ -1,15 +1,22 @@
+#include <nano/lib/locks.hpp>
+#include <nano/lib/thread_roles.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
+#include <nano/store/delegator.hpp>
 #include <nano/store/frontier.hpp>
 
-nano::store::component::component (nano::store::block & block_store_a, nano::store::frontier & frontier_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a) :
+#include <deque>
+#include <thread>
+
+nano::store::component::component (nano::store::block & block_store_a, nano::store::frontier & frontier_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::delegator & delegator_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a) :
 	block (block_store_a),
 	frontier (frontier_store_a),
 	account (account_store_a),
 	pending (pending_store_a),
+	delegator (delegator_store_a),
 	online_weight (online_weight_store_a),
 	pruned (pruned_store_a),
 	peer (peer_store_a),
@@ -35,6 +42,79 @@ void nano::store::component::initialize (store::write_transaction const & transa
 	ledger_cache_a.final_votes_confirmation_canary = (constants.final_votes_canary_account == constants.genesis->account () && 1 >= constants.final_votes_canary_height);
 	account.put (transaction_a, constants.genesis->account (), { hash_l, constants.genesis->account (), constants.genesis->hash (), std::numeric_limits<nano::uint128_t>::max (), nano::seconds_since_epoch (), 1, nano::epoch::epoch_0 });
 	++ledger_cache_a.account_count;
+	delegator.put (transaction_a, { constants.genesis->account (), constants.genesis->account () });
 	ledger_cache_a.rep_weights.representation_put (constants.genesis->account (), std::numeric_limits<nano::uint128_t>::max ());
 	frontier.put (transaction_a, hash_l, constants.genesis->account ());
 }
+
+void nano::store::component::fill_delegators (store::write_transaction & transaction_a)
+{
+	std::size_t constexpr batch_size = 64 * 1024;
+	std::size_t constexpr max_batches = 16;
+
+	delegator.clear (transaction_a);
+	// Commit so the read transactions scanning the accounts table see every table opened by this transaction
+	transaction_a.refresh ();
+
+	nano::mutex mutex;
+	nano::condition_variable condition;
+	std::deque<std::vector<nano::delegator_key>> batches;
+	bool done{ false };
+
+	std::thread reader ([&] () {
+		nano::thread_role::set (nano::thread_role::name::db_parallel_traversal);
+		account.for_each_par ([&] (store::read_transaction const &, store::iterator<nano::account, nano::account_info> i, store::iterator<nano::account, nano::account_info> n) {
+			std::vector<nano::delegator_key> batch;
+			auto push = [&] () {
+				nano::unique_lock<nano::mutex> lock{ mutex };
+				condition.wait (lock, [&] () { return batches.size () < max_batches; });
+				batches.push_back (std::move (batch));
+				lock.unlock ();
+				condition.notify_all ();
+				batch = {};
+			};
+			for (; i != n; ++i)
+			{
+				batch.emplace_back (i->second.representative, i->first);
+				if (batch.size () >= batch_size)
+				{
+					push ();
+				}
+			}
+			if (!batch.empty ())
+			{
+				push ();
+			}
+		});
+		{
+			nano::lock_guard<nano::mutex> guard{ mutex };
+			done = true;
+		}
+		condition.notify_all ();
+	});
+
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!done || !batches.empty ())
+	{
+		if (!batches.empty ())
+		{
+			auto batch = std::move (batches.front ());
+			batches.pop_front ();
+			lock.unlock ();
+			condition.notify_all ();
+			for (auto const & key : batch)
+			{
+				delegator.put (transaction_a, key);
+			}
+			// Bounds the size of each write transaction
+			transaction_a.refresh ();
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+	lock.unlock ();
+	reader.join ();
+}
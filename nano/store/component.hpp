@@ -20,6 +20,7 @@ namespace store
 	class account;
 	class block;
 	class confirmation_height;
+	class delegator;
 	class final_vote;
 	class frontier;
 	class online_weight;
@@ -47,6 +48,7 @@ namespace store
 		nano::store::frontier &,
 		nano::store::account &,
 		nano::store::pending &,
+		nano::store::delegator &,
 		nano::store::online_weight&,
 		nano::store::pruned &,
 		nano::store::peer &,
@@ -68,8 +70,9 @@ namespace store
 		store::frontier & frontier;
 		store::account & account;
 		store::pending & pending;
+		store::delegator & delegator;
 		static int constexpr version_minimum{ 21 };
-		static int constexpr version_current{ 22 };
+		static int constexpr version_current{ 23 };
 
 	public:
 		store::online_weight & online_weight;
@@ -87,6 +90,10 @@ namespace store
 		/** Not applicable to all sub-classes */
 		virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 		virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
+		/** Forces commits that were not synced on commit to disk, not applicable to all sub-classes */
+		virtual void flush (){};
+		/** Leaves syncing of commits made by the calling thread to flush () while \p defer_a is set, not applicable to all sub-classes */
+		virtual void defer_sync (bool defer_a){};
 
 		virtual bool init_error () const = 0;
 
@@ -97,6 +104,13 @@ namespace store
 		virtual read_transaction tx_begin_read () const = 0;
 
 		virtual std::string vendor_get () const = 0;
+
+	protected:
+		/**
+		 * Fills the delegators index from the accounts table.
+		 * Account ranges are read in parallel while the calling thread, which owns \p transaction_a, writes the entries and commits periodically.
+		 */
+		void fill_delegators (write_transaction & transaction_a);
 	};
 } // namespace store
 } // namespace nano
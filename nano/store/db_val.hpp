@@ -70,6 +70,12 @@ public:
 		static_assert (std::is_standard_layout<nano::pending_key>::value, "Standard layout is required");
 	}
 
+	db_val (nano::delegator_key const & val_a) :
+		db_val (sizeof (val_a), const_cast<nano::delegator_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::delegator_key>::value, "Standard layout is required");
+	}
+
 	db_val (nano::confirmation_height_info const & val_a) :
 		buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -147,6 +153,15 @@ public:
 		return result;
 	}
 
+	explicit operator nano::delegator_key () const
+	{
+		nano::delegator_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (nano::delegator_key::representative) + sizeof (nano::delegator_key::account) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator nano::confirmation_height_info () const
 	{
 		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
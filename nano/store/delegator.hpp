@@ -0,0 +1,24 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/iterator.hpp>
+
+namespace nano::store
+{
+/**
+ * Manages the index from representatives to the accounts delegating to them, kept in step with the accounts table by the ledger
+ * Entries are sorted by representative then account so the delegators of a representative are contiguous
+ */
+class delegator
+{
+public:
+	virtual void put (store::write_transaction const &, nano::delegator_key const &) = 0;
+	virtual void del (store::write_transaction const &, nano::delegator_key const &) = 0;
+	virtual bool exists (store::transaction const &, nano::delegator_key const &) const = 0;
+	virtual void clear (store::write_transaction const &) = 0;
+	virtual store::iterator<nano::delegator_key, std::nullptr_t> begin (store::transaction const &, nano::delegator_key const &) const = 0;
+	virtual store::iterator<nano::delegator_key, std::nullptr_t> begin (store::transaction const &) const = 0;
+	virtual store::iterator<nano::delegator_key, std::nullptr_t> end () const = 0;
+};
+} // namespace nano::store
@@ -87,20 +87,37 @@ std::shared_ptr<nano::block> nano::store::lmdb::block::get (store::transaction c
 	std::shared_ptr<nano::block> result;
 	if (value.size () != 0)
 	{
-		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-		nano::block_type type;
-		auto error (try_read (stream, type));
-		release_assert (!error);
-		result = nano::deserialize_block (stream, type);
-		release_assert (result != nullptr);
-		nano::block_sideband sideband;
-		error = (sideband.deserialize (stream, type));
-		release_assert (!error);
-		result->sideband_set (sideband);
+		auto data = reinterpret_cast<uint8_t const *> (value.data ());
+		result = cache.get (hash, data, value.size ());
+		if (result == nullptr)
+		{
+			nano::bufferstream stream (data, value.size ());
+			nano::block_type type;
+			auto error (try_read (stream, type));
+			release_assert (!error);
+			result = nano::deserialize_block (stream, type);
+			release_assert (result != nullptr);
+			nano::block_sideband sideband;
+			error = (sideband.deserialize (stream, type));
+			release_assert (!error);
+			result->sideband_set (sideband);
+			cache.put (hash, data, value.size (), result);
+		}
 	}
 	return result;
 }
 
+std::optional<nano::block_hash> nano::store::lmdb::block::get_serialized (store::transaction const & transaction_a, nano::block_hash const & hash_a, std::vector<uint8_t> & buffer_a) const
+{
+	nano::store::lmdb::db_val value;
+	block_raw_get (transaction_a, hash_a, value);
+	if (value.size () == 0)
+	{
+		return std::nullopt;
+	}
+	return append_serialized (reinterpret_cast<uint8_t const *> (value.data ()), value.size (), buffer_a);
+}
+
 std::shared_ptr<nano::block> nano::store::lmdb::block::random (store::transaction const & transaction)
 {
 	nano::block_hash hash;
@@ -118,6 +135,7 @@ void nano::store::lmdb::block::del (store::write_transaction const & transaction
 {
 	auto status = store.del (transaction_a, tables::blocks, hash_a);
 	store.release_assert_success (status);
+	cache.erase (hash_a);
 }
 
 bool nano::store::lmdb::block::exists (store::transaction const & transaction, nano::block_hash const & hash)
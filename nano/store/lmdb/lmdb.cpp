@@ -19,6 +19,7 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 		frontier_store,
 		account_store,
 		pending_store,
+		delegator_store,
 		online_weight_store,
 		pruned_store,
 		peer_store,
@@ -31,6 +32,7 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 	frontier_store{ *this },
 	account_store{ *this },
 	pending_store{ *this },
+	delegator_store{ *this },
 	online_weight_store{ *this },
 	pruned_store{ *this },
 	peer_store{ *this },
@@ -147,6 +149,17 @@ void nano::store::lmdb::component::serialize_mdb_tracker (boost::property_tree::
 	mdb_txn_tracker.serialize_json (json, min_read_time, min_write_time);
 }
 
+void nano::store::lmdb::component::flush ()
+{
+	auto status (mdb_env_sync (env.environment, true));
+	release_assert (status == 0);
+}
+
+void nano::store::lmdb::component::defer_sync (bool defer_a)
+{
+	nano::store::lmdb::env::sync_deferred = defer_a;
+}
+
 void nano::store::lmdb::component::serialize_memory_stats (boost::property_tree::ptree & json)
 {
 	MDB_stat stats;
@@ -203,6 +216,7 @@ void nano::store::lmdb::component::open_databases (bool & error_a, store::transa
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_store.pending_v0_handle) != 0;
 	pending_store.pending_handle = pending_store.pending_v0_handle;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "final_votes", flags, &final_vote_store.final_votes_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "delegators", flags, &delegator_store.delegators_handle) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "blocks", MDB_CREATE, &block_store.blocks_handle) != 0;
 }
 
@@ -221,6 +235,9 @@ bool nano::store::lmdb::component::do_upgrades (store::write_transaction & trans
 			upgrade_v21_to_v22 (transaction_a);
 			[[fallthrough]];
 		case 22:
+			upgrade_v22_to_v23 (transaction_a);
+			[[fallthrough]];
+		case 23:
 			break;
 		default:
 			logger.critical (nano::log::type::lmdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -242,6 +259,16 @@ void nano::store::lmdb::component::upgrade_v21_to_v22 (store::write_transaction
 	logger.info (nano::log::type::lmdb, "Upgrading database from v21 to v22 completed");
 }
 
+void nano::store::lmdb::component::upgrade_v22_to_v23 (store::write_transaction & transaction_a)
+{
+	logger.info (nano::log::type::lmdb, "Upgrading database from v22 to v23...");
+
+	fill_delegators (transaction_a);
+	version.put (transaction_a, 23);
+
+	logger.info (nano::log::type::lmdb, "Upgrading database from v22 to v23 completed");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::store::lmdb::component::create_backup_file (nano::store::lmdb::env & env_a, std::filesystem::path const & filepath_a, nano::logger & logger)
 {
@@ -339,6 +366,8 @@ MDB_dbi nano::store::lmdb::component::table_to_dbi (tables table_a) const
 			return confirmation_height_store.confirmation_height_handle;
 		case tables::final_votes:
 			return final_vote_store.final_votes_handle;
+		case tables::delegators:
+			return delegator_store.delegators_handle;
 		default:
 			release_assert (false);
 			return peer_store.peers_handle;
@@ -418,6 +447,27 @@ void nano::store::lmdb::component::rebuild_db (store::write_transaction const &
 		release_assert (count (transaction_a, pending_store.pending_handle) == count (transaction_a, temp));
 		mdb_drop (env.tx (transaction_a), temp, 1);
 	}
+	// Delegators table
+	{
+		MDB_dbi temp;
+		mdb_dbi_open (env.tx (transaction_a), "temp_table", MDB_CREATE, &temp);
+		// Copy all values to temporary table
+		for (auto i (store::iterator<nano::delegator_key, std::nullptr_t> (std::make_unique<nano::store::lmdb::iterator<nano::delegator_key, std::nullptr_t>> (transaction_a, env, delegator_store.delegators_handle))), n (store::iterator<nano::delegator_key, std::nullptr_t> (nullptr)); i != n; ++i)
+		{
+			auto s = mdb_put (env.tx (transaction_a), temp, nano::store::lmdb::db_val (i->first), nano::store::lmdb::db_val (nullptr), MDB_APPEND);
+			release_assert_success (s);
+		}
+		release_assert (count (transaction_a, delegator_store.delegators_handle) == count (transaction_a, temp));
+		mdb_drop (env.tx (transaction_a), delegator_store.delegators_handle, 0);
+		// Put values from copy
+		for (auto i (store::iterator<nano::delegator_key, std::nullptr_t> (std::make_unique<nano::store::lmdb::iterator<nano::delegator_key, std::nullptr_t>> (transaction_a, env, temp))), n (store::iterator<nano::delegator_key, std::nullptr_t> (nullptr)); i != n; ++i)
+		{
+			auto s = mdb_put (env.tx (transaction_a), delegator_store.delegators_handle, nano::store::lmdb::db_val (i->first), nano::store::lmdb::db_val (nullptr), MDB_APPEND);
+			release_assert_success (s);
+		}
+		release_assert (count (transaction_a, delegator_store.delegators_handle) == count (transaction_a, temp));
+		mdb_drop (env.tx (transaction_a), temp, 1);
+	}
 }
 
 bool nano::store::lmdb::component::init_error () const
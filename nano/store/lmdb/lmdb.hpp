@@ -10,6 +10,7 @@
 #include <nano/store/lmdb/block.hpp>
 #include <nano/store/lmdb/confirmation_height.hpp>
 #include <nano/store/lmdb/db_val.hpp>
+#include <nano/store/lmdb/delegator.hpp>
 #include <nano/store/lmdb/final_vote.hpp>
 #include <nano/store/lmdb/frontier.hpp>
 #include <nano/store/lmdb/iterator.hpp>
@@ -43,6 +44,7 @@ private:
 	nano::store::lmdb::account account_store;
 	nano::store::lmdb::block block_store;
 	nano::store::lmdb::confirmation_height confirmation_height_store;
+	nano::store::lmdb::delegator delegator_store;
 	nano::store::lmdb::final_vote final_vote_store;
 	nano::store::lmdb::frontier frontier_store;
 	nano::store::lmdb::online_weight online_weight_store;
@@ -54,6 +56,7 @@ private:
 	friend class nano::store::lmdb::account;
 	friend class nano::store::lmdb::block;
 	friend class nano::store::lmdb::confirmation_height;
+	friend class nano::store::lmdb::delegator;
 	friend class nano::store::lmdb::final_vote;
 	friend class nano::store::lmdb::frontier;
 	friend class nano::store::lmdb::online_weight;
@@ -74,6 +77,8 @@ public:
 	static void create_backup_file (nano::store::lmdb::env &, std::filesystem::path const &, nano::logger &);
 
 	void serialize_memory_stats (boost::property_tree::ptree &) override;
+	void flush () override;
+	void defer_sync (bool defer_a) override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -113,6 +118,7 @@ public:
 private:
 	bool do_upgrades (store::write_transaction &, nano::ledger_constants & constants, bool &);
 	void upgrade_v21_to_v22 (store::write_transaction const &);
+	void upgrade_v22_to_v23 (store::write_transaction &);
 
 	void open_databases (bool &, store::transaction const &, unsigned);
 
@@ -154,6 +160,7 @@ private:
 
 	friend class mdb_block_store_supported_version_upgrades_Test;
 	friend class mdb_block_store_upgrade_v21_v22_Test;
+	friend class mdb_block_store_upgrade_v22_v23_Test;
 	friend class block_store_DISABLED_change_dupsort_Test;
 };
 } // namespace nano::store::lmdb
@@ -1,6 +1,8 @@
 #include <nano/lib/utility.hpp>
 #include <nano/store/lmdb/lmdb_env.hpp>
 
+thread_local bool nano::store::lmdb::env::sync_deferred{ false };
+
 nano::store::lmdb::env::env (bool & error_a, std::filesystem::path const & path_a, nano::store::lmdb::env::options options_a)
 {
 	init (error_a, path_a, options_a);
@@ -39,9 +41,11 @@ void nano::store::lmdb::env::init (bool & error_a, std::filesystem::path const &
 			{
 				environment_flags |= MDB_NOMETASYNC;
 			}
-			else if (options_a.config.sync == nano::lmdb_config::sync_strategy::nosync_unsafe)
+			else if (options_a.config.sync == nano::lmdb_config::sync_strategy::nosync_unsafe || options_a.config.sync == nano::lmdb_config::sync_strategy::group_commit)
 			{
+				// With group commit the write queue flushes explicitly at the end of every group, other commits sync themselves
 				environment_flags |= MDB_NOSYNC;
+				group_commit = options_a.config.sync == nano::lmdb_config::sync_strategy::group_commit;
 			}
 			else if (options_a.config.sync == nano::lmdb_config::sync_strategy::nosync_unsafe_large_memory)
 			{
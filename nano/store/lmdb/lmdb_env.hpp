@@ -64,5 +64,9 @@ public:
 	MDB_txn * tx (store::transaction const & transaction_a) const;
 	MDB_env * environment;
 	nano::id_t const store_id{ nano::next_id () };
+	/** Opened with the group_commit sync strategy, commits are synced individually unless the committing thread defers them */
+	bool group_commit{ false };
+	/** Set while this thread holds a write queue turn, the queue then syncs the whole group of commits at once */
+	static thread_local bool sync_deferred;
 };
 } // namespace nano::store::lmdb
@@ -92,6 +92,12 @@ void nano::store::lmdb::write_transaction_impl::commit ()
 		{
 			release_assert (false && "Unable to write to the LMDB database", mdb_strerror (status));
 		}
+		if (env.group_commit && !nano::store::lmdb::env::sync_deferred)
+		{
+			// Not part of a write queue group, nothing else is going to sync this commit
+			auto sync_status = mdb_env_sync (env, true);
+			release_assert (sync_status == MDB_SUCCESS, mdb_strerror (sync_status));
+		}
 		txn_callbacks.txn_end (this);
 		active = false;
 	}
@@ -0,0 +1,43 @@
+#include <nano/store/rocksdb/delegator.hpp>
+#include <nano/store/rocksdb/rocksdb.hpp>
+
+nano::store::rocksdb::delegator::delegator (nano::store::rocksdb::component & store_a) :
+	store{ store_a } {};
+
+void nano::store::rocksdb::delegator::put (store::write_transaction const & transaction_a, nano::delegator_key const & key_a)
+{
+	auto status = store.put (transaction_a, tables::delegators, key_a, nullptr);
+	store.release_assert_success (status);
+}
+
+void nano::store::rocksdb::delegator::del (store::write_transaction const & transaction_a, nano::delegator_key const & key_a)
+{
+	auto status = store.del (transaction_a, tables::delegators, key_a);
+	store.release_assert_success (status);
+}
+
+bool nano::store::rocksdb::delegator::exists (store::transaction const & transaction_a, nano::delegator_key const & key_a) const
+{
+	return store.exists (transaction_a, tables::delegators, key_a);
+}
+
+void nano::store::rocksdb::delegator::clear (store::write_transaction const & transaction_a)
+{
+	auto status = store.drop (transaction_a, tables::delegators);
+	store.release_assert_success (status);
+}
+
+nano::store::iterator<nano::delegator_key, std::nullptr_t> nano::store::rocksdb::delegator::begin (store::transaction const & transaction_a, nano::delegator_key const & key_a) const
+{
+	return store.make_iterator<nano::delegator_key, std::nullptr_t> (transaction_a, tables::delegators, key_a);
+}
+
+nano::store::iterator<nano::delegator_key, std::nullptr_t> nano::store::rocksdb::delegator::begin (store::transaction const & transaction_a) const
+{
+	return store.make_iterator<nano::delegator_key, std::nullptr_t> (transaction_a, tables::delegators);
+}
+
+nano::store::iterator<nano::delegator_key, std::nullptr_t> nano::store::rocksdb::delegator::end () const
+{
+	return store::iterator<nano::delegator_key, std::nullptr_t> (nullptr);
+}
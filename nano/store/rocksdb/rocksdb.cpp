@@ -41,6 +41,7 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 		frontier_store,
 		account_store,
 		pending_store,
+		delegator_store,
 		online_weight_store,
 		pruned_store,
 		peer_store,
@@ -53,6 +54,7 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 	frontier_store{ *this },
 	account_store{ *this },
 	pending_store{ *this },
+	delegator_store{ *this },
 	online_weight_store{ *this },
 	pruned_store{ *this },
 	peer_store{ *this },
@@ -171,7 +173,8 @@ std::unordered_map<char const *, nano::tables> nano::store::rocksdb::component::
 		{ "peers", tables::peers },
 		{ "confirmation_height", tables::confirmation_height },
 		{ "pruned", tables::pruned },
-		{ "final_votes", tables::final_votes } };
+		{ "final_votes", tables::final_votes },
+		{ "delegators", tables::delegators } };
 
 	debug_assert (map.size () == all_tables ().size () + 1);
 	return map;
@@ -208,7 +211,7 @@ void nano::store::rocksdb::component::open (bool & error_a, std::filesystem::pat
 	error_a |= !s.ok ();
 }
 
-bool nano::store::rocksdb::component::do_upgrades (store::write_transaction const & transaction_a)
+bool nano::store::rocksdb::component::do_upgrades (store::write_transaction & transaction_a)
 {
 	bool error_l{ false };
 	auto version_l = version.get (transaction_a);
@@ -241,6 +244,9 @@ bool nano::store::rocksdb::component::do_upgrades (store::write_transaction cons
 			upgrade_v21_to_v22 (transaction_a);
 			[[fallthrough]];
 		case 22:
+			upgrade_v22_to_v23 (transaction_a);
+			[[fallthrough]];
+		case 23:
 			break;
 		default:
 			logger.critical (nano::log::type::rocksdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -276,11 +282,29 @@ void nano::store::rocksdb::component::upgrade_v21_to_v22 (store::write_transacti
 	logger.info (nano::log::type::rocksdb, "Upgrading database from v21 to v22 completed");
 }
 
+void nano::store::rocksdb::component::upgrade_v22_to_v23 (store::write_transaction & transaction_a)
+{
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v22 to v23...");
+
+	if (!column_family_exists ("delegators"))
+	{
+		::rocksdb::ColumnFamilyHandle * delegators_handle;
+		auto status = db->CreateColumnFamily (get_cf_options ("delegators"), "delegators", &delegators_handle);
+		release_assert (status.ok ());
+		handles.emplace_back (delegators_handle);
+	}
+	fill_delegators (transaction_a);
+	version.put (transaction_a, 23);
+
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v22 to v23 completed");
+}
+
 void nano::store::rocksdb::component::generate_tombstone_map ()
 {
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::blocks), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::accounts), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::pending), std::forward_as_tuple (0, 25000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::delegators), std::forward_as_tuple (0, 25000));
 }
 
 rocksdb::ColumnFamilyOptions nano::store::rocksdb::component::get_common_cf_options (std::shared_ptr<::rocksdb::TableFactory> const & table_factory_a, unsigned long long memtable_size_bytes_a) const
@@ -378,6 +402,12 @@ rocksdb::ColumnFamilyOptions nano::store::rocksdb::component::get_cf_options (st
 		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
+	else if (cf_name_a == "delegators")
+	{
+		// Deletions on every representative change and rollback
+		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
 	else if (cf_name_a == "final_votes")
 	{
 		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
@@ -508,6 +538,8 @@ rocksdb::ColumnFamilyHandle * nano::store::rocksdb::component::table_to_column_f
 			return get_column_family ("confirmation_height");
 		case tables::final_votes:
 			return get_column_family ("final_votes");
+		case tables::delegators:
+			return get_column_family ("delegators");
 		default:
 			release_assert (false);
 			return get_column_family ("");
@@ -665,6 +697,13 @@ uint64_t nano::store::rocksdb::component::count (store::transaction const & tran
 			++sum;
 		}
 	}
+	else if (table_a == tables::delegators)
+	{
+		for (auto i (delegator.begin (transaction_a)), n (delegator.end ()); i != n; ++i)
+		{
+			++sum;
+		}
+	}
 	else
 	{
 		debug_assert (false);
@@ -849,7 +888,7 @@ void nano::store::rocksdb::component::on_flush (::rocksdb::FlushJobInfo const &
 
 std::vector<nano::tables> nano::store::rocksdb::component::all_tables () const
 {
-	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::vote };
+	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::delegators, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::vote };
 }
 
 bool nano::store::rocksdb::component::copy_db (std::filesystem::path const & destination_path)
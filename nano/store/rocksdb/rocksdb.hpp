@@ -8,6 +8,7 @@
 #include <nano/store/rocksdb/account.hpp>
 #include <nano/store/rocksdb/block.hpp>
 #include <nano/store/rocksdb/confirmation_height.hpp>
+#include <nano/store/rocksdb/delegator.hpp>
 #include <nano/store/rocksdb/final_vote.hpp>
 #include <nano/store/rocksdb/frontier.hpp>
 #include <nano/store/rocksdb/iterator.hpp>
@@ -44,6 +45,7 @@ private:
 	nano::store::rocksdb::account account_store;
 	nano::store::rocksdb::block block_store;
 	nano::store::rocksdb::confirmation_height confirmation_height_store;
+	nano::store::rocksdb::delegator delegator_store;
 	nano::store::rocksdb::final_vote final_vote_store;
 	nano::store::rocksdb::frontier frontier_store;
 	nano::store::rocksdb::online_weight online_weight_store;
@@ -56,6 +58,7 @@ public:
 	friend class nano::store::rocksdb::account;
 	friend class nano::store::rocksdb::block;
 	friend class nano::store::rocksdb::confirmation_height;
+	friend class nano::store::rocksdb::delegator;
 	friend class nano::store::rocksdb::final_vote;
 	friend class nano::store::rocksdb::frontier;
 	friend class nano::store::rocksdb::online_weight;
@@ -149,8 +152,9 @@ private:
 
 	void open (bool & error_a, std::filesystem::path const & path_a, bool open_read_only_a, ::rocksdb::Options const & options_a, std::vector<::rocksdb::ColumnFamilyDescriptor> column_families);
 
-	bool do_upgrades (store::write_transaction const &);
+	bool do_upgrades (store::write_transaction &);
 	void upgrade_v21_to_v22 (store::write_transaction const &);
+	void upgrade_v22_to_v23 (store::write_transaction &);
 
 	void construct_column_family_mutexes ();
 	::rocksdb::Options get_db_options ();
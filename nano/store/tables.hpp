@@ -11,6 +11,7 @@ enum class tables
 	blocks,
 	confirmation_height,
 	default_unused, // RocksDB only
+	delegators,
 	final_votes,
 	frontiers,
 	meta,
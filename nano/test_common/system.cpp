@@ -6,6 +6,8 @@
 #include <boost/asio.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <cryptopp/words.h>
+
 #include <cstdlib>
 
 using namespace std::chrono_literals;